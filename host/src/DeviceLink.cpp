@@ -0,0 +1,203 @@
+#include "DeviceLink.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "BinaryFrame.h"
+
+// Credits lost on the wire would stall us forever; start over after this long
+static const uint64_t CREDIT_TIMEOUT_MS = 3000;
+
+// Rates worth trying, fastest first; all are standard termios speeds
+static const uint32_t BAUD_LADDER[] = { 2000000, 1000000, 921600, 460800, 230400 };
+
+static uint64_t nowMs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Same clock as the agent stamps tagged frames with
+static uint32_t nowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint32_t>(static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000);
+}
+
+bool DeviceLink::requestHello() {
+  static const char command[] = "\nhello\n";  // leading newline ends any partial line
+  return port.write(reinterpret_cast<const uint8_t*>(command), sizeof(command) - 1);
+}
+
+bool DeviceLink::waitForHello(uint32_t timeoutMs) {
+  uint64_t deadline = nowMs() + timeoutMs;
+  while (!helloSeen && nowMs() < deadline) {
+    poll(nowMs());
+    usleep(5000);
+  }
+  return helloSeen;
+}
+
+uint32_t DeviceLink::negotiateBaud(uint32_t maxBaud) {
+  uint32_t limit = maxBaud < deviceMaxBaud ? maxBaud : deviceMaxBaud;
+  for (uint32_t rate : BAUD_LADDER) {
+    if (rate <= limit && rate > port.baud() && tryBaud(rate)) {
+      break;
+    }
+  }
+  return port.baud();
+}
+
+// One round of the handshake: ask at the current rate, switch on "ok", send
+// the probe at the new rate and keep it only if the device confirms
+bool DeviceLink::tryBaud(uint32_t rate) {
+  uint32_t from = port.baud();
+  char command[24];
+  int length = snprintf(command, sizeof(command), "baud %u\n", rate);
+  baudReply = BAUD_NONE;
+  if (!port.write(reinterpret_cast<const uint8_t*>(command), length) ||
+      !waitForBaud(rate, BAUD_OK, 500)) {
+    return false;
+  }
+
+  if (!port.setBaud(rate)) {
+    return false;  // the device reverts on its own once the trial times out
+  }
+  usleep(20000);  // the device switches as soon as its reply has gone out
+
+  uint8_t payload[PROBE_SIZE];
+  uint8_t frame[PROBE_SIZE + FRAME_OVERHEAD];
+  fillProbePattern(payload);
+  size_t frameLength = encodeFrame(FRAME_PROBE, payload, PROBE_SIZE, frame);
+  if (port.write(frame, frameLength) && waitForBaud(rate, BAUD_CONFIRM, 1000)) {
+    return true;
+  }
+
+  port.setBaud(from);
+  waitForBaud(from, BAUD_REVERT, 2000);  // stay in step for the next attempt
+  return false;
+}
+
+bool DeviceLink::waitForBaud(uint32_t rate, BaudStatus status, uint32_t timeoutMs) {
+  uint64_t deadline = nowMs() + timeoutMs;
+  while (nowMs() < deadline) {
+    poll(nowMs());
+    if (baudReply == BAUD_REFUSED) {
+      return false;
+    }
+    if (baudReply == status && baudReplyRate == rate) {
+      return true;
+    }
+    usleep(2000);
+  }
+  return false;
+}
+
+void DeviceLink::poll(uint64_t nowMs) {
+  uint8_t chunk[256];
+  int n;
+  while ((n = port.read(chunk, sizeof(chunk))) > 0) {
+    for (int i = 0; i < n; i++) {
+      char c = static_cast<char>(chunk[i]);
+      if (c == '\n' || c == '\r') {
+        line[lineLength] = '\0';
+        if (lineLength > 0) {
+          handleLine(line, nowMs);
+        }
+        lineLength = 0;
+      } else if (lineLength < sizeof(line) - 1) {
+        line[lineLength++] = c;
+      }
+    }
+  }
+}
+
+// Value of `key=` in a record, or `fallback` when it is missing
+static uint32_t field(const char* line, const char* key, uint32_t fallback) {
+  const char* p = strstr(line, key);
+  return p ? strtoul(p + strlen(key), nullptr, 10) : fallback;
+}
+
+void DeviceLink::handleLine(char* text, uint64_t nowMs) {
+  if (strncmp(text, "@hello", 6) == 0) {
+    helloSeen = true;
+    resync = true;
+    clockRequest = true;
+    proto = field(text, "proto=", 1);
+    hosts = field(text, "hosts=", 0);
+    window = field(text, "window=", 1);
+    deviceMaxBaud = field(text, "maxbaud=", 0);
+    interval = field(text, "interval=", 1000);
+    inFlight = 0;
+    lastCredit = nowMs;
+    fprintf(stderr, "Device: %s\n", text + 1);
+  } else if (strncmp(text, "@rate ", 6) == 0) {
+    interval = strtoul(text + 6, nullptr, 10);
+    fprintf(stderr, "Device asked for %s\n", interval ? text + 1 : "a pause");
+  } else if (strncmp(text, "@credit ", 8) == 0) {
+    uint32_t credit = strtoul(text + 8, nullptr, 10);
+    inFlight = credit < inFlight ? inFlight - credit : 0;
+    lastCredit = nowMs;
+  } else if (strncmp(text, "@baud ", 6) == 0) {
+    char* status;
+    baudReplyRate = strtoul(text + 6, &status, 10);
+    if (strcmp(status, " ok") == 0) {
+      baudReply = BAUD_OK;
+    } else if (strcmp(status, " confirm") == 0) {
+      baudReply = BAUD_CONFIRM;
+      fprintf(stderr, "Serial link now at %u baud\n", baudReplyRate);
+    } else if (strcmp(status, " revert") == 0) {
+      baudReply = BAUD_REVERT;
+    } else if (strcmp(status, " fallback") == 0) {
+      // The device gave up on the current rate; follow it down
+      fprintf(stderr, "Device fell back to %u baud\n", baudReplyRate);
+      port.setBaud(baudReplyRate);
+    } else {
+      baudReply = BAUD_REFUSED;
+    }
+  } else if (strncmp(text, "@clock", 6) == 0) {
+    clockRequest = true;
+  } else if (strncmp(text, "@lat ", 5) == 0) {
+    latencyStats.onEcho(text + 5, nowUs());
+  } else if (text[0] == '@') {
+    fprintf(stderr, "Device: %s\n", text + 1);
+  }
+}
+
+bool DeviceLink::canSend(uint64_t nowMs) {
+  if (!helloSeen) {
+    return true;
+  }
+  if (inFlight > 0 && nowMs - lastCredit >= CREDIT_TIMEOUT_MS) {
+    inFlight = 0;
+    // Nothing is getting through; a negotiated rate is the likely culprit.
+    // The device drops back too once it sees only noise.
+    if (port.baud() != baseBaud && port.setBaud(baseBaud)) {
+      fprintf(stderr, "No credit from the device, back to %u baud\n", baseBaud);
+      requestHello();
+    }
+  }
+  return inFlight < window;
+}
+
+void DeviceLink::onSent(uint64_t nowMs) {
+  if (inFlight == 0) {
+    lastCredit = nowMs;  // the timeout runs from the oldest unanswered frame
+  }
+  inFlight++;
+}
+
+bool DeviceLink::takeResync() {
+  bool pending = resync;
+  resync = false;
+  return pending;
+}
+
+bool DeviceLink::takeClockRequest() {
+  bool pending = clockRequest;
+  clockRequest = false;
+  return pending;
+}
@@ -0,0 +1,88 @@
+/*
+ *  GearPulse host agent - device back-channel
+ *  --------------------------------------
+ *  The device answers on the same serial link with text records starting
+ *  with '@': @hello announces its limits and preferred interval, @rate
+ *  changes the interval (0 = pause), @credit returns frames it has
+ *  consumed, @baud answers rate negotiation, @clock asks for a new
+ *  clock sync and @lat echoes a sequence-tagged frame. Anything else it
+ *  prints is log output and is ignored.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "LatencyStats.h"
+#include "SerialPort.h"
+
+class DeviceLink {
+ public:
+  explicit DeviceLink(SerialPort& port) : port(port), baseBaud(port.baud()) {}
+
+  // Ask the device to announce itself; older firmware just ignores it
+  bool requestHello();
+  bool waitForHello(uint32_t timeoutMs);
+
+  // Move both ends to the fastest rate up to `maxBaud` that passes a probe
+  // frame, trying lower rates in turn. Returns the rate in use afterwards.
+  uint32_t negotiateBaud(uint32_t maxBaud);
+
+  // Read and act on whatever the device has sent; never blocks
+  void poll(uint64_t nowMs);
+
+  // True once a @hello has been seen; until then the link runs open-loop
+  bool announced() const { return helloSeen; }
+
+  // Host IDs the device has slots for, 0 until it says
+  uint32_t hostSlots() const { return hosts; }
+
+  // Interval the device asked for, 0 while it wants no data
+  uint32_t intervalMs() const { return interval; }
+
+  // Flow control: a frame may be sent while the device has credit left
+  bool canSend(uint64_t nowMs);
+  void onSent(uint64_t nowMs);
+
+  // True once after a @hello, when the device may have lost its state
+  bool takeResync();
+
+  // The device keeps its own time from FRAME_CLOCK syncs (protocol 2)
+  bool clockSync() const { return helloSeen && proto >= 2; }
+
+  // The device takes FRAME_METRICS with the whole schema (protocol 3)
+  bool metricFrames() const { return helloSeen && proto >= 3; }
+
+  // True once after a @hello or @clock, when the device wants a sync now
+  bool takeClockRequest();
+
+  // The device echoes sequence-tagged frames with @lat (protocol 4)
+  bool latencyEcho() const { return helloSeen && proto >= 4; }
+  LatencyStats& latency() { return latencyStats; }
+
+ private:
+  enum BaudStatus { BAUD_NONE, BAUD_OK, BAUD_CONFIRM, BAUD_REVERT, BAUD_REFUSED };
+
+  void handleLine(char* line, uint64_t nowMs);
+  bool tryBaud(uint32_t rate);
+  bool waitForBaud(uint32_t rate, BaudStatus status, uint32_t timeoutMs);
+
+  SerialPort& port;
+  uint32_t baseBaud;
+  uint32_t deviceMaxBaud = 0;
+  uint32_t baudReplyRate = 0;
+  BaudStatus baudReply = BAUD_NONE;
+  char line[160];
+  size_t lineLength = 0;
+  bool helloSeen = false;
+  bool resync = false;
+  bool clockRequest = false;
+  uint32_t proto = 0;
+  uint32_t hosts = 0;
+  uint32_t interval = 0;
+  uint32_t window = 0;
+  uint32_t inFlight = 0;
+  uint64_t lastCredit = 0;
+  LatencyStats latencyStats;
+};
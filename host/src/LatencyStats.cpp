@@ -0,0 +1,125 @@
+#include "LatencyStats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static uint8_t bucketFor(uint32_t us) {
+  if (us < 4) {
+    return static_cast<uint8_t>(us);
+  }
+  uint8_t msb = 31 - __builtin_clz(us);
+  return static_cast<uint8_t>((msb - 1) * 4 + ((us >> (msb - 2)) & 3));
+}
+
+static uint32_t bucketTop(uint8_t bucket) {
+  if (bucket < 4) {
+    return bucket;
+  }
+  uint8_t msb = bucket / 4 + 1;
+  uint64_t low = static_cast<uint64_t>(4 + bucket % 4) << (msb - 2);
+  uint64_t top = low + (static_cast<uint64_t>(1) << (msb - 2)) - 1;
+  return top > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(top);
+}
+
+void LatencyHistogram::add(uint32_t us) {
+  buckets[bucketFor(us)]++;
+  samples++;
+  if (us > largest) {
+    largest = us;
+  }
+}
+
+void LatencyHistogram::clear() {
+  memset(buckets, 0, sizeof(buckets));
+  samples = 0;
+  largest = 0;
+}
+
+uint32_t LatencyHistogram::percentile(uint32_t p) const {
+  if (samples == 0) {
+    return 0;
+  }
+  uint64_t rank = (static_cast<uint64_t>(samples) * p + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t i = 0; i < BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      uint32_t top = bucketTop(i);
+      return top < largest ? top : largest;
+    }
+  }
+  return largest;
+}
+
+// Value of `key=` in a record; false when it is missing
+static bool field(const char* record, const char* key, uint32_t& value) {
+  const char* p = strstr(record, key);
+  if (!p) {
+    return false;
+  }
+  value = strtoul(p + strlen(key), nullptr, 10);
+  return true;
+}
+
+bool LatencyStats::onEcho(const char* record, uint32_t nowUs) {
+  uint32_t seq, sent, rx, done, drawn;
+  if (!field(record, "seq=", seq) || !field(record, "sent=", sent) || !field(record, "rx=", rx) ||
+      !field(record, "done=", done)) {
+    return false;
+  }
+  bool shown = field(record, "drawn=", drawn);
+
+  // Gaps in the sequence are frames that never came back. Immediate echoes
+  // can overtake ones waiting for the render tick, so a late one is
+  // taken back off the lost count.
+  if (!haveSeq || seq == nextSeq) {
+    nextSeq = seq + 1;
+  } else if (static_cast<int32_t>(seq - nextSeq) > 0) {
+    lost += seq - nextSeq;
+    nextSeq = seq + 1;
+  } else if (lost > 0) {
+    lost--;
+  }
+  haveSeq = true;
+
+  // All differences are taken modulo 2^32, so both clocks may wrap
+  uint32_t rtt = nowUs - sent;
+  uint32_t dwell = (shown ? drawn : done) - rx;
+  uint32_t oneWay = rtt > dwell ? (rtt - dwell) / 2 : 0;
+  wire.add(oneWay);
+  parse.add(done - rx);
+  if (shown) {
+    render.add(drawn - done);
+    glass.add(oneWay + (drawn - rx));
+  } else {
+    undrawn++;
+  }
+  return true;
+}
+
+static void printStage(FILE* out, const char* name, const LatencyHistogram& stage) {
+  if (stage.count() == 0) {
+    return;
+  }
+  fprintf(out, "  %-7s p50 %7.2f  p90 %7.2f  p99 %7.2f  max %7.2f ms  (%u)\n", name,
+          stage.percentile(50) / 1000.0, stage.percentile(90) / 1000.0, stage.percentile(99) / 1000.0,
+          stage.max() / 1000.0, stage.count());
+}
+
+void LatencyStats::report(FILE* out) {
+  if (echoes() == 0 && lost == 0) {
+    return;
+  }
+  fprintf(out, "Latency: %u echoed, %u not shown, %u lost\n", echoes(), undrawn, lost);
+  printStage(out, "wire", wire);
+  printStage(out, "parse", parse);
+  printStage(out, "render", render);
+  printStage(out, "glass", glass);
+
+  wire.clear();
+  parse.clear();
+  render.clear();
+  glass.clear();
+  undrawn = 0;
+  lost = 0;
+}
@@ -0,0 +1,58 @@
+/*
+ *  GearPulse host agent - end-to-end latency
+ *  --------------------------------------
+ *  Frames sent with a sequence tag come back as @lat records carrying the
+ *  device's own timestamps: when the frame's first byte arrived, when it
+ *  was applied and when the page showing it reached the panel. The host
+ *  clock only ever measures the round trip, so the one-way wire time is
+ *  taken as half of what the device did not spend on the frame itself.
+ *
+ *  Each stage is kept in a histogram with four buckets per octave, enough
+ *  for percentiles within about 20% at a fixed 500 bytes per stage.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+class LatencyHistogram {
+ public:
+  void add(uint32_t us);
+  void clear();
+
+  uint32_t count() const { return samples; }
+  uint32_t max() const { return largest; }
+
+  // Upper bound of the bucket holding the p-th percentile, at most max()
+  uint32_t percentile(uint32_t p) const;
+
+ private:
+  static const uint8_t BUCKETS = 124;  // four per octave over 32 bits
+
+  uint32_t buckets[BUCKETS] = {0};
+  uint32_t samples = 0;
+  uint32_t largest = 0;
+};
+
+class LatencyStats {
+ public:
+  // Take one @lat record, received at `nowUs` on the clock that stamped
+  // `sent`. Returns false for a malformed record.
+  bool onEcho(const char* record, uint32_t nowUs);
+
+  // Print the percentiles since the last report and start over
+  void report(FILE* out);
+
+  uint32_t echoes() const { return wire.count(); }
+
+ private:
+  LatencyHistogram wire;    // host to device, one way
+  LatencyHistogram parse;   // first byte to applied, including the rest of the frame
+  LatencyHistogram render;  // applied to on the panel
+  LatencyHistogram glass;   // sent to on the panel
+  uint32_t undrawn = 0;     // applied but never shown: another host or page, or superseded
+  uint32_t lost = 0;        // never echoed: dropped on the wire or rejected
+  uint32_t nextSeq = 0;
+  bool haveSeq = false;
+};
@@ -0,0 +1,384 @@
+#include "LinuxSensors.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// hwmon drivers that report the CPU package temperature as temp1, best first
+static const char* const CPU_HWMON_NAMES[] = { "coretemp", "k10temp", "zenpower", "cpu_thermal", "acpitz" };
+static const int CPU_HWMON_COUNT = sizeof(CPU_HWMON_NAMES) / sizeof(CPU_HWMON_NAMES[0]);
+
+static int openReadOnly(const char* path) {
+  return ::open(path, O_RDONLY | O_CLOEXEC);
+}
+
+static void closeFd(int& fd) {
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+// Busy and total jiffies from one /proc/stat cpu line, after its name:
+// user nice system idle iowait irq softirq steal
+static void readCpuTimes(char*& p, uint64_t& busy, uint64_t& total) {
+  uint64_t fields[8] = {0};
+  for (int i = 0; i < 8; i++) {
+    fields[i] = strtoull(p, &p, 10);
+  }
+  total = 0;
+  for (int i = 0; i < 8; i++) {
+    total += fields[i];
+  }
+  busy = total - fields[3] - fields[4];
+}
+
+// Read a short sysfs attribute such as a hwmon name, stripping the newline
+static bool readAttribute(const char* path, char* out, size_t size) {
+  int fd = openReadOnly(path);
+  if (fd < 0) {
+    return false;
+  }
+  ssize_t n = ::read(fd, out, size - 1);
+  ::close(fd);
+  if (n <= 0) {
+    return false;
+  }
+  out[n] = '\0';
+  out[strcspn(out, "\n")] = '\0';
+  return true;
+}
+
+LinuxSensors::~LinuxSensors() {
+  closeFd(statFd);
+  closeFd(meminfoFd);
+  closeFd(netDevFd);
+  closeFd(cpuTempFd);
+  closeFd(gpuTempFd);
+  closeFd(gpuBusyFd);
+  closeFd(diskstatsFd);
+  closeFd(fanFd);
+  closeFd(vramUsedFd);
+  closeFd(vramTotalFd);
+}
+
+bool LinuxSensors::open(const char* netInterface) {
+  statFd = openReadOnly("/proc/stat");
+  meminfoFd = openReadOnly("/proc/meminfo");
+  netDevFd = openReadOnly("/proc/net/dev");
+  if (statFd < 0 || meminfoFd < 0 || netDevFd < 0) {
+    return false;
+  }
+
+  if (netInterface) {
+    snprintf(netFilter, sizeof(netFilter), "%s", netInterface);
+  }
+
+  // Disk throughput: whole disks only, partitions would count bytes twice
+  diskstatsFd = openReadOnly("/proc/diskstats");
+  DIR* dir = opendir("/sys/block");
+  if (dir) {
+    static const char* const VIRTUAL[] = { "loop", "ram", "zram", "dm-", "md" };
+    while (dirent* entry = readdir(dir)) {
+      bool skip = entry->d_name[0] == '.' || diskCount >= MAX_DISKS;
+      for (const char* prefix : VIRTUAL) {
+        skip = skip || strncmp(entry->d_name, prefix, strlen(prefix)) == 0;
+      }
+      if (!skip) {
+        snprintf(disks[diskCount++], sizeof(disks[0]), "%.31s", entry->d_name);
+      }
+    }
+    closedir(dir);
+  }
+
+  // Temperatures: pick the best CPU driver, and amdgpu for the GPU
+  char path[512];
+  char name[32];
+  int cpuRank = CPU_HWMON_COUNT;
+  dir = opendir("/sys/class/hwmon");
+  if (dir) {
+    while (dirent* entry = readdir(dir)) {
+      if (entry->d_name[0] == '.') {
+        continue;
+      }
+      snprintf(path, sizeof(path), "/sys/class/hwmon/%s/name", entry->d_name);
+      if (!readAttribute(path, name, sizeof(name))) {
+        continue;
+      }
+
+      // The first fan on a board or CPU driver; the GPU's own fan is not it
+      if (fanFd < 0 && strcmp(name, "amdgpu") != 0) {
+        snprintf(path, sizeof(path), "/sys/class/hwmon/%s/fan1_input", entry->d_name);
+        fanFd = openReadOnly(path);
+        if (fanFd >= 0) {
+          snprintf(fanName, sizeof(fanName), "%s", name);
+        }
+      }
+
+      snprintf(path, sizeof(path), "/sys/class/hwmon/%s/temp1_input", entry->d_name);
+
+      if (strcmp(name, "amdgpu") == 0 && gpuTempFd < 0) {
+        gpuTempFd = openReadOnly(path);
+        continue;
+      }
+      for (int rank = 0; rank < cpuRank; rank++) {
+        if (strcmp(name, CPU_HWMON_NAMES[rank]) == 0) {
+          int fd = openReadOnly(path);
+          if (fd >= 0) {
+            closeFd(cpuTempFd);
+            cpuTempFd = fd;
+            cpuRank = rank;
+            snprintf(cpuTempName, sizeof(cpuTempName), "%s", name);
+          }
+          break;
+        }
+      }
+    }
+    closedir(dir);
+  }
+  if (cpuTempFd < 0) {
+    cpuTempFd = openReadOnly("/sys/class/thermal/thermal_zone0/temp");
+    if (cpuTempFd >= 0) {
+      snprintf(cpuTempName, sizeof(cpuTempName), "thermal_zone0");
+    }
+  }
+
+  // GPU load: amdgpu (and some other drivers) expose gpu_busy_percent,
+  // with the VRAM counters next to it
+  dir = opendir("/sys/class/drm");
+  if (dir) {
+    while (dirent* entry = readdir(dir)) {
+      if (strncmp(entry->d_name, "card", 4) != 0 || strchr(entry->d_name, '-')) {
+        continue;
+      }
+      snprintf(path, sizeof(path), "/sys/class/drm/%s/device/gpu_busy_percent", entry->d_name);
+      gpuBusyFd = openReadOnly(path);
+      if (gpuBusyFd >= 0) {
+        snprintf(path, sizeof(path), "/sys/class/drm/%s/device/mem_info_vram_used", entry->d_name);
+        vramUsedFd = openReadOnly(path);
+        snprintf(path, sizeof(path), "/sys/class/drm/%s/device/mem_info_vram_total", entry->d_name);
+        vramTotalFd = openReadOnly(path);
+        break;
+      }
+    }
+    closedir(dir);
+  }
+
+  return true;
+}
+
+void LinuxSensors::describe() const {
+  fprintf(stderr, "CPU temperature: %s\n", cpuTempFd >= 0 ? cpuTempName : "not found");
+  fprintf(stderr, "GPU temperature: %s\n", gpuTempFd >= 0 ? "amdgpu" : "not found");
+  fprintf(stderr, "GPU load: %s\n", gpuBusyFd >= 0 ? "gpu_busy_percent" : "not found");
+  fprintf(stderr, "Network: %s\n", netFilter[0] ? netFilter : "all interfaces except lo");
+  fprintf(stderr, "Fan: %s\n", fanFd >= 0 ? fanName : "not found");
+  fprintf(stderr, "VRAM: %s\n", vramTotalFd >= 0 ? "mem_info_vram" : "not found");
+  fprintf(stderr, "Disks:");
+  for (int i = 0; i < diskCount; i++) {
+    fprintf(stderr, " %s", disks[i]);
+  }
+  fprintf(stderr, "%s\n", diskCount ? "" : " none");
+}
+
+int LinuxSensors::readFile(int fd) {
+  if (fd < 0) {
+    return -1;
+  }
+  ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+  if (n < 0) {
+    return -1;
+  }
+  buffer[n] = '\0';
+  return static_cast<int>(n);
+}
+
+int32_t LinuxSensors::readMilli(int fd) {
+  if (readFile(fd) <= 0) {
+    return 0;
+  }
+  return static_cast<int32_t>(strtol(buffer, nullptr, 10));
+}
+
+void LinuxSensors::sample(SystemData& data, uint32_t elapsedMs) {
+  sampleCpu(data);
+  sampleMemory(data);
+  sampleNetwork(data, elapsedMs);
+  sampleDisks(data, elapsedMs);
+
+  // hwmon reports millidegrees, SystemData wants tenths
+  data.cpuTemp = static_cast<int16_t>(readMilli(cpuTempFd) / 100);
+  data.gpuTemp = static_cast<int16_t>(readMilli(gpuTempFd) / 100);
+  data.gpuLoad = gpuBusyFd >= 0 ? static_cast<uint16_t>(readMilli(gpuBusyFd) * LOAD_SCALE) : 0;
+  data.fanRpm = static_cast<uint16_t>(readMilli(fanFd));
+
+  // VRAM counters are in bytes
+  const uint64_t bytesPerGb = 1024ull * 1024 * 1024;
+  if (vramTotalFd >= 0 && readFile(vramTotalFd) > 0) {
+    data.vramTotal = static_cast<uint16_t>((strtoull(buffer, nullptr, 10) * RAM_SCALE + bytesPerGb / 2) / bytesPerGb);
+  }
+  if (vramUsedFd >= 0 && readFile(vramUsedFd) > 0) {
+    data.vramUsed = static_cast<uint16_t>((strtoull(buffer, nullptr, 10) * RAM_SCALE + bytesPerGb / 2) / bytesPerGb);
+  }
+
+  primed = true;
+}
+
+void LinuxSensors::sampleCpu(SystemData& data) {
+  if (readFile(statFd) <= 0 || strncmp(buffer, "cpu ", 4) != 0) {
+    return;
+  }
+
+  // The aggregate "cpu" line, then one "cpuN" line per core
+  data.cores.count = 0;
+  char* p = buffer;
+  while (strncmp(p, "cpu", 3) == 0) {
+    p += 3;
+    long core = *p == ' ' ? -1 : strtol(p, &p, 10);
+    uint64_t busy, total;
+    readCpuTimes(p, busy, total);
+
+    if (core < 0) {
+      uint64_t deltaTotal = total - lastCpuTotal;
+      data.cpuLoad = (primed && deltaTotal > 0 && busy >= lastCpuBusy)
+                       ? static_cast<uint16_t>((busy - lastCpuBusy) * 100 * LOAD_SCALE / deltaTotal)
+                       : 0;
+      lastCpuTotal = total;
+      lastCpuBusy = busy;
+    } else if (core < MAX_CORES) {
+      uint64_t deltaTotal = total - lastCoreTotal[core];
+      data.cores.load[core] = (primed && deltaTotal > 0 && busy >= lastCoreBusy[core])
+                                ? static_cast<uint8_t>((busy - lastCoreBusy[core]) * 100 * CORE_SCALE / deltaTotal)
+                                : 0;
+      if (core >= data.cores.count) {
+        data.cores.count = static_cast<uint8_t>(core + 1);
+      }
+      lastCoreTotal[core] = total;
+      lastCoreBusy[core] = busy;
+    }
+
+    p = strchr(p, '\n');
+    if (!p) {
+      break;
+    }
+    p++;
+  }
+}
+
+void LinuxSensors::sampleMemory(SystemData& data) {
+  if (readFile(meminfoFd) <= 0) {
+    return;
+  }
+
+  uint64_t totalKb = 0;
+  uint64_t availableKb = 0;
+  const char* total = strstr(buffer, "MemTotal:");
+  const char* available = strstr(buffer, "MemAvailable:");
+  if (total) {
+    totalKb = strtoull(total + 9, nullptr, 10);
+  }
+  if (available) {
+    availableKb = strtoull(available + 13, nullptr, 10);
+  }
+  if (totalKb == 0 || availableKb > totalKb) {
+    return;
+  }
+
+  // GiB in SystemData's 0.01 units
+  const uint64_t kbPerGb = 1024 * 1024;
+  uint64_t usedKb = totalKb - availableKb;
+  data.ramTotal = static_cast<uint16_t>((totalKb * RAM_SCALE + kbPerGb / 2) / kbPerGb);
+  data.ramUsed = static_cast<uint16_t>((usedKb * RAM_SCALE + kbPerGb / 2) / kbPerGb);
+  data.ramPercent = static_cast<uint16_t>(usedKb * 100 * LOAD_SCALE / totalKb);
+}
+
+void LinuxSensors::sampleNetwork(SystemData& data, uint32_t elapsedMs) {
+  if (readFile(netDevFd) <= 0) {
+    return;
+  }
+
+  // Two header lines, then "  name: rx_bytes packets errs drop fifo frame
+  // compressed multicast tx_bytes ..."
+  uint64_t rx = 0;
+  uint64_t tx = 0;
+  char* line = strchr(buffer, '\n');
+  line = line ? strchr(line + 1, '\n') : nullptr;
+  while (line && *++line) {
+    char* colon = strchr(line, ':');
+    char* end = strchr(line, '\n');
+    if (!colon || (end && colon > end)) {
+      break;
+    }
+    *colon = '\0';
+    char* name = line + strspn(line, " ");
+    bool wanted = netFilter[0] ? strcmp(name, netFilter) == 0 : strcmp(name, "lo") != 0;
+
+    char* p = colon + 1;
+    uint64_t rxBytes = strtoull(p, &p, 10);
+    for (int i = 0; i < 7; i++) {
+      strtoull(p, &p, 10);
+    }
+    uint64_t txBytes = strtoull(p, &p, 10);
+    if (wanted) {
+      rx += rxBytes;
+      tx += txBytes;
+    }
+    line = end;
+  }
+
+  // Counters can go backwards when an interface disappears; skip that interval
+  if (primed && elapsedMs > 0 && rx >= lastRx && tx >= lastTx) {
+    data.netDownload = static_cast<uint32_t>((rx - lastRx) * 1000 / elapsedMs);
+    data.netUpload = static_cast<uint32_t>((tx - lastTx) * 1000 / elapsedMs);
+  } else {
+    data.netDownload = 0;
+    data.netUpload = 0;
+  }
+  lastRx = rx;
+  lastTx = tx;
+}
+
+bool LinuxSensors::wholeDisk(const char* name) const {
+  for (int i = 0; i < diskCount; i++) {
+    if (strcmp(name, disks[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LinuxSensors::sampleDisks(SystemData& data, uint32_t elapsedMs) {
+  if (readFile(diskstatsFd) <= 0) {
+    return;
+  }
+
+  // "major minor name reads merged sectors ms writes merged sectors ...",
+  // sectors always being 512 bytes here
+  uint64_t read = 0;
+  uint64_t written = 0;
+  char* line = buffer;
+  while (line && *line) {
+    char name[32];
+    unsigned long long sectorsRead, sectorsWritten;
+    if (sscanf(line, "%*u %*u %31s %*u %*u %llu %*u %*u %*u %llu", name, &sectorsRead, &sectorsWritten) == 3 &&
+        wholeDisk(name)) {
+      read += sectorsRead * 512;
+      written += sectorsWritten * 512;
+    }
+    line = strchr(line, '\n');
+    line = line ? line + 1 : nullptr;
+  }
+
+  if (primed && elapsedMs > 0 && read >= lastDiskRead && written >= lastDiskWrite) {
+    data.diskRead = static_cast<uint32_t>((read - lastDiskRead) * 1000 / elapsedMs);
+    data.diskWrite = static_cast<uint32_t>((written - lastDiskWrite) * 1000 / elapsedMs);
+  } else {
+    data.diskRead = 0;
+    data.diskWrite = 0;
+  }
+  lastDiskRead = read;
+  lastDiskWrite = written;
+}
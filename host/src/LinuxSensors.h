@@ -0,0 +1,75 @@
+/*
+ *  GearPulse host agent - Linux sensor sampling
+ *  --------------------------------------
+ *  Reads /proc and /sys. Every file is opened once at startup and re-read
+ *  with pread() into a fixed buffer, so sampling does no allocation and
+ *  only a handful of syscalls.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "SystemData.h"
+
+class LinuxSensors {
+ public:
+  LinuxSensors() = default;
+  ~LinuxSensors();
+  LinuxSensors(const LinuxSensors&) = delete;
+  LinuxSensors& operator=(const LinuxSensors&) = delete;
+
+  // Locate the proc files and hwmon/drm sensors. Returns false only when the
+  // essential /proc files are missing; absent temperature, fan, disk or GPU
+  // sensors simply report 0.
+  bool open(const char* netInterface = nullptr);
+
+  // Fill the metric fields of `data`. Loads and network and disk rates are
+  // computed from counter deltas since the previous call, `elapsedMs` apart;
+  // the first call only primes the counters and reports zero for them.
+  void sample(SystemData& data, uint32_t elapsedMs);
+
+  void describe() const;  // print the discovered sensors to stderr
+
+ private:
+  int readFile(int fd);
+  void sampleCpu(SystemData& data);
+  void sampleMemory(SystemData& data);
+  void sampleNetwork(SystemData& data, uint32_t elapsedMs);
+  void sampleDisks(SystemData& data, uint32_t elapsedMs);
+  bool wholeDisk(const char* name) const;
+  int32_t readMilli(int fd);
+
+  int statFd = -1;
+  int meminfoFd = -1;
+  int netDevFd = -1;
+  int cpuTempFd = -1;
+  int gpuTempFd = -1;
+  int gpuBusyFd = -1;
+  int diskstatsFd = -1;
+  int fanFd = -1;
+  int vramUsedFd = -1;
+  int vramTotalFd = -1;
+
+  char cpuTempName[32] = "";
+  char netFilter[32] = "";
+  char fanName[32] = "";
+
+  // Block devices that are disks rather than partitions, loop or device-mapper
+  // volumes, so every byte counts once
+  static const int MAX_DISKS = 16;
+  char disks[MAX_DISKS][32];
+  int diskCount = 0;
+
+  bool primed = false;
+  uint64_t lastCpuBusy = 0;
+  uint64_t lastCpuTotal = 0;
+  uint64_t lastCoreBusy[MAX_CORES] = {0};
+  uint64_t lastCoreTotal[MAX_CORES] = {0};
+  uint64_t lastRx = 0;
+  uint64_t lastTx = 0;
+  uint64_t lastDiskRead = 0;
+  uint64_t lastDiskWrite = 0;
+
+  char buffer[32768];
+};
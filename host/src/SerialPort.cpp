@@ -0,0 +1,126 @@
+#include "SerialPort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudConstant(uint32_t baud) {
+  switch (baud) {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    case 460800:  return B460800;
+    case 921600:  return B921600;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    default:      return 0;
+  }
+}
+
+bool SerialPort::open(const char* path, uint32_t baud) {
+  close();
+
+  if (strcmp(path, "-") == 0) {
+    handle = STDOUT_FILENO;
+    ownsHandle = false;
+    return true;
+  }
+
+  speed_t speed = baudConstant(baud);
+  if (!speed) {
+    fprintf(stderr, "Unsupported baud rate %u\n", baud);
+    return false;
+  }
+
+  handle = ::open(path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+  if (handle < 0) {
+    fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+  ownsHandle = true;
+
+  termios tty;
+  if (tcgetattr(handle, &tty) != 0) {
+    fprintf(stderr, "Cannot configure %s: %s\n", path, strerror(errno));
+    close();
+    return false;
+  }
+  cfmakeraw(&tty);
+  cfsetispeed(&tty, speed);
+  cfsetospeed(&tty, speed);
+  tty.c_cflag |= CLOCAL | CREAD;
+  tty.c_cflag &= ~(CSTOPB | CRTSCTS);
+  tty.c_cc[VMIN] = 0;
+  tty.c_cc[VTIME] = 0;
+  if (tcsetattr(handle, TCSANOW, &tty) != 0) {
+    fprintf(stderr, "Cannot configure %s: %s\n", path, strerror(errno));
+    close();
+    return false;
+  }
+  tcflush(handle, TCIOFLUSH);
+  this->speed = baud;
+
+  return true;
+}
+
+bool SerialPort::setBaud(uint32_t baud) {
+  speed_t constant = baudConstant(baud);
+  termios tty;
+  if (!ownsHandle || !constant || tcgetattr(handle, &tty) != 0) {
+    return false;
+  }
+  tcdrain(handle);
+  cfsetispeed(&tty, constant);
+  cfsetospeed(&tty, constant);
+  if (tcsetattr(handle, TCSANOW, &tty) != 0) {
+    return false;
+  }
+  speed = baud;
+  return true;
+}
+
+void SerialPort::close() {
+  if (ownsHandle && handle >= 0) {
+    ::close(handle);
+  }
+  handle = -1;
+  ownsHandle = false;
+  speed = 0;
+}
+
+bool SerialPort::write(const uint8_t* data, size_t length) {
+  while (length > 0) {
+    ssize_t n = ::write(handle, data, length);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    length -= n;
+  }
+  return true;
+}
+
+int SerialPort::read(uint8_t* data, size_t capacity) {
+  if (!ownsHandle) {
+    return 0;
+  }
+  for (;;) {
+    ssize_t n = ::read(handle, data, capacity);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && errno == EAGAIN) {
+      return 0;
+    }
+    return static_cast<int>(n);
+  }
+}
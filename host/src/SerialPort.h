@@ -0,0 +1,36 @@
+/*
+ *  GearPulse host agent - raw serial port
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class SerialPort {
+ public:
+  ~SerialPort() { close(); }
+
+  // Open a tty in raw 8N1 mode. A path of "-" writes to stdout instead,
+  // which is handy for piping frames into other tools.
+  bool open(const char* path, uint32_t baud);
+  void close();
+
+  // Switch speed after the pending output has been sent. Fails for stdout.
+  bool setBaud(uint32_t baud);
+  uint32_t baud() const { return speed; }
+
+  // Write the whole buffer, retrying on short writes
+  bool write(const uint8_t* data, size_t length);
+
+  // Read whatever is waiting without blocking. Returns the byte count, 0 when
+  // nothing is pending (always, for stdout) and -1 on error.
+  int read(uint8_t* data, size_t capacity);
+
+  int fd() const { return handle; }
+
+ private:
+  int handle = -1;
+  bool ownsHandle = false;
+  uint32_t speed = 0;
+};
@@ -0,0 +1,379 @@
+/*
+ *  GearPulse host agent
+ *  --------------------------------------
+ *  Samples CPU, GPU, RAM and network on a fixed cadence and streams binary
+ *  frames to the device: a full snapshot every few samples and deltas with
+ *  only the changed fields in between. After startup the loop allocates
+ *  nothing and spends almost all of its time in clock_nanosleep().
+ *
+ *  Devices that announce themselves with @hello set the pace: the agent
+ *  follows their @rate requests and never has more frames in flight than
+ *  the device has credited back. Devices with their own clock (protocol 2)
+ *  get a clock sync every few minutes instead of the time in every frame.
+ *  With --latency, metric frames carry a sequence tag that protocol 4
+ *  devices echo back, and the agent reports where the time went.
+ */
+
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "BinaryFrame.h"
+#include "DeviceLink.h"
+#include "LinuxSensors.h"
+#include "SerialPort.h"
+
+struct Options {
+  const char* port = "/dev/ttyUSB0";
+  uint32_t baud = 115200;        // both ends start here
+  uint32_t maxBaud = 921600;     // negotiated upwards when the device agrees
+  uint32_t intervalMs = 1000;    // until the device asks for a rate
+  uint32_t minIntervalMs = 100;  // fastest rate we agree to
+  uint32_t keyframeEvery = 10;  // samples between full snapshots
+  const char* netInterface = nullptr;
+  bool clock24h = false;
+  int hostId = -1;  // untagged frames unless set
+  bool latency = false;
+  bool verbose = false;
+};
+
+// Host slots on the device; @hello may announce fewer
+const int MAX_HOSTS = 4;
+
+// Between clock syncs; the device corrects its own drift in between
+const uint64_t CLOCK_SYNC_MS = 10 * 60 * 1000;
+
+// Between latency reports with --latency
+const uint64_t LATENCY_REPORT_MS = 60 * 1000;
+
+// Date and time fields, left out of every frame once the device keeps time
+const FieldMask CLOCK_FIELDS = FIELD_YEAR | FIELD_MONTH | FIELD_DAY | FIELD_HOUR | FIELD_MINUTE | FIELD_SECOND | FIELD_PERIOD;
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int) {
+  running = 0;
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -p, --port PATH      serial device, or - for stdout (default /dev/ttyUSB0)\n"
+          "  -b, --baud RATE      starting baud rate (default 115200)\n"
+          "  -B, --max-baud RATE  fastest rate to negotiate, 0 to stay put (default 921600)\n"
+          "  -i, --interval MS    sample interval until the device sets one (default 1000)\n"
+          "  -m, --min-interval MS  never sample faster than this (default 100)\n"
+          "  -k, --keyframe N     send a full snapshot every N samples (default 10)\n"
+          "  -n, --iface NAME     only count traffic on this network interface\n"
+          "  -I, --host-id N      tag frames with host ID N (0-3) for multi-host displays\n"
+          "      --24h            show 24-hour time without AM/PM\n"
+          "  -L, --latency        tag frames and report end-to-end latency every minute\n"
+          "  -v, --verbose        print every sample to stderr\n",
+          argv0);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+  static const option longOptions[] = {
+    { "port", required_argument, nullptr, 'p' },
+    { "baud", required_argument, nullptr, 'b' },
+    { "max-baud", required_argument, nullptr, 'B' },
+    { "interval", required_argument, nullptr, 'i' },
+    { "min-interval", required_argument, nullptr, 'm' },
+    { "keyframe", required_argument, nullptr, 'k' },
+    { "iface", required_argument, nullptr, 'n' },
+    { "host-id", required_argument, nullptr, 'I' },
+    { "24h", no_argument, nullptr, 'H' },
+    { "latency", no_argument, nullptr, 'L' },
+    { "verbose", no_argument, nullptr, 'v' },
+    { "help", no_argument, nullptr, 'h' },
+    { nullptr, 0, nullptr, 0 },
+  };
+
+  int c;
+  while ((c = getopt_long(argc, argv, "p:b:B:i:m:k:n:I:Lvh", longOptions, nullptr)) != -1) {
+    switch (c) {
+      case 'p': options.port = optarg; break;
+      case 'b': options.baud = strtoul(optarg, nullptr, 10); break;
+      case 'B': options.maxBaud = strtoul(optarg, nullptr, 10); break;
+      case 'i': options.intervalMs = strtoul(optarg, nullptr, 10); break;
+      case 'm': options.minIntervalMs = strtoul(optarg, nullptr, 10); break;
+      case 'k': options.keyframeEvery = strtoul(optarg, nullptr, 10); break;
+      case 'n': options.netInterface = optarg; break;
+      case 'I': {
+        char* end;
+        long id = strtol(optarg, &end, 10);
+        if (end == optarg || *end != '\0' || id < 0 || id >= MAX_HOSTS) {
+          fprintf(stderr, "Host ID must be between 0 and %d\n", MAX_HOSTS - 1);
+          return false;
+        }
+        options.hostId = static_cast<int>(id);
+        break;
+      }
+      case 'H': options.clock24h = true; break;
+      case 'L': options.latency = true; break;
+      case 'v': options.verbose = true; break;
+      default: return false;
+    }
+  }
+
+  if (options.intervalMs < 10 || options.minIntervalMs < 10 || options.keyframeEvery == 0) {
+    fprintf(stderr, "Intervals must be at least 10 ms and keyframe at least 1\n");
+    return false;
+  }
+  if (options.latency && strcmp(options.port, "-") == 0) {
+    fprintf(stderr, "Latency needs a serial device to echo frames\n");
+    return false;
+  }
+  return true;
+}
+
+// Frame a payload, tagged with the host ID when one was given and with `tag`
+// unless it is null
+static size_t frameFor(const Options& options, FrameKind kind, const uint8_t* payload, uint8_t length,
+                       uint8_t* out, const FrameTag* tag = nullptr) {
+  if (tag) {
+    return encodeTaggedFrame(static_cast<int16_t>(options.hostId), *tag, kind, payload, length, out);
+  }
+  if (options.hostId >= 0) {
+    return encodeHostFrame(static_cast<uint8_t>(options.hostId), kind, payload, length, out);
+  }
+  return encodeFrame(kind, payload, length, out);
+}
+
+static void sampleClock(SystemData& data, bool clock24h) {
+  time_t now = time(nullptr);
+  tm local;
+  localtime_r(&now, &local);
+
+  data.datetime.year = local.tm_year + 1900;
+  data.datetime.month = local.tm_mon + 1;
+  data.datetime.day = local.tm_mday;
+  data.datetime.minute = local.tm_min;
+  data.datetime.second = local.tm_sec;
+  if (clock24h) {
+    data.datetime.hour = local.tm_hour;
+    memset(data.datetime.period, 0, sizeof(data.datetime.period));
+  } else {
+    data.datetime.hour = local.tm_hour % 12 == 0 ? 12 : local.tm_hour % 12;
+    memcpy(data.datetime.period, local.tm_hour < 12 ? "AM" : "PM", 3);
+  }
+}
+
+// The wall clock now, for devices that keep their own time
+static ClockSync clockNow(bool clock24h) {
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  tm local;
+  localtime_r(&ts.tv_sec, &local);
+
+  ClockSync sync;
+  sync.epoch = static_cast<uint32_t>(ts.tv_sec);
+  sync.millis = static_cast<uint16_t>(ts.tv_nsec / 1000000);
+  sync.offsetMinutes = static_cast<int16_t>(local.tm_gmtoff / 60);
+  sync.hour12 = !clock24h;
+  return sync;
+}
+
+static uint64_t monotonicMs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Wraps every 71 minutes; echoes only ever compare nearby values
+static uint32_t monotonicUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint32_t>(static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000);
+}
+
+// Sleep until `deadline`, reading echoes as they arrive so their receipt
+// time is not rounded up to the next sample
+static void waitForEchoes(SerialPort& port, DeviceLink& link, const timespec& deadline) {
+  while (running) {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t leftMs = (deadline.tv_sec - now.tv_sec) * 1000 + (deadline.tv_nsec - now.tv_nsec) / 1000000;
+    if (leftMs <= 0) {
+      return;
+    }
+    pollfd watch = { port.fd(), POLLIN, 0 };
+    if (::poll(&watch, 1, static_cast<int>(leftMs)) > 0) {
+      link.poll(monotonicMs());
+    }
+  }
+}
+
+// The device's requested interval once it has announced itself, else ours.
+// A paused device is still polled at our own interval.
+static uint32_t currentInterval(const Options& options, const DeviceLink& link) {
+  if (!link.announced() || link.intervalMs() == 0) {
+    return options.intervalMs;
+  }
+  return link.intervalMs() > options.minIntervalMs ? link.intervalMs() : options.minIntervalMs;
+}
+
+static void addMs(timespec& ts, uint32_t ms) {
+  ts.tv_sec += ms / 1000;
+  ts.tv_nsec += static_cast<long>(ms % 1000) * 1000000;
+  if (ts.tv_nsec >= 1000000000) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000;
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  LinuxSensors sensors;
+  if (!sensors.open(options.netInterface)) {
+    fprintf(stderr, "Cannot open /proc sensor files\n");
+    return 1;
+  }
+  if (options.verbose) {
+    sensors.describe();
+  }
+
+  SerialPort port;
+  if (!port.open(options.port, options.baud)) {
+    return 1;
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  SystemData data;
+  SystemData sent;
+  memset(&data, 0, sizeof(data));
+  memset(&sent, 0, sizeof(sent));
+
+  uint8_t payload[METRICS_MAX_SIZE];
+  uint8_t frame[METRICS_MAX_SIZE + FRAME_OVERHEAD + 1 + FRAME_TAG_SIZE];
+
+  DeviceLink link(port);
+  link.requestHello();
+  if (options.maxBaud > options.baud && link.waitForHello(1000)) {
+    uint32_t rate = link.negotiateBaud(options.maxBaud);
+    if (options.verbose) {
+      fprintf(stderr, "Using %u baud\n", rate);
+    }
+  }
+
+  timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  uint64_t lastSample = monotonicMs();
+  sensors.sample(data, 0);  // prime the counters
+  uint32_t sinceKeyframe = 0;
+  uint64_t lastClockSync = 0;
+  uint64_t lastReport = lastSample;
+  uint32_t seq = 0;
+  size_t length;
+
+  while (running) {
+    addMs(next, currentInterval(options, link));
+    if (options.latency) {
+      waitForEchoes(port, link, next);
+    }
+    while (running && clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) != 0) {
+    }
+    if (!running) {
+      break;
+    }
+
+    // Nothing is sampled while the device is paused or out of credit; the
+    // next delta simply covers everything that changed meanwhile
+    uint64_t now = monotonicMs();
+    link.poll(now);
+    if (options.hostId >= 0 && link.hostSlots() && static_cast<uint32_t>(options.hostId) >= link.hostSlots()) {
+      fprintf(stderr, "Device only has %u host slots\n", link.hostSlots());
+      return 1;
+    }
+    if (options.latency && now - lastReport >= LATENCY_REPORT_MS) {
+      link.latency().report(stderr);
+      lastReport = now;
+    }
+    if ((link.announced() && link.intervalMs() == 0) || !link.canSend(now)) {
+      continue;
+    }
+
+    // A clock sync takes a credit like any other frame
+    if (link.clockSync() && (link.takeClockRequest() || now - lastClockSync >= CLOCK_SYNC_MS)) {
+      length = frameFor(options, FRAME_CLOCK, payload, encodeClockV1(clockNow(options.clock24h), payload), frame);
+      if (!port.write(frame, length)) {
+        perror("Serial write failed");
+        return 1;
+      }
+      link.onSent(now);
+      lastClockSync = now;
+      if (!link.canSend(now)) {
+        continue;
+      }
+    }
+
+    sensors.sample(data, static_cast<uint32_t>(now - lastSample));
+    if (link.clockSync()) {
+      memset(&data.datetime, 0, sizeof(data.datetime));  // left out of every delta
+    } else {
+      sampleClock(data, options.clock24h);
+    }
+    lastSample = now;
+
+    if (link.takeResync()) {
+      sinceKeyframe = 0;
+    }
+
+    // Newer devices take every metric in one frame kind; older ones only
+    // know the snapshot fields
+    FieldMask fields = link.metricFrames() ? FIELD_ALL : FIELD_SNAPSHOT;
+    if (link.clockSync()) {
+      fields &= ~CLOCK_FIELDS;
+    }
+    FieldMask mask = sinceKeyframe == 0 ? fields : changedFields(sent, data) & fields;
+    if (mask == 0) {
+      sinceKeyframe = (sinceKeyframe + 1) % options.keyframeEvery;
+      continue;
+    }
+    if (link.metricFrames()) {
+      uint8_t payloadLength = encodeMetrics(data, mask, payload);
+      FrameTag tag = { seq, monotonicUs() };
+      bool tagged = options.latency && link.latencyEcho();
+      length = frameFor(options, FRAME_METRICS, payload, payloadLength, frame, tagged ? &tag : nullptr);
+      seq += tagged;
+    } else if (sinceKeyframe == 0) {
+      length = frameFor(options, FRAME_SNAPSHOT, payload, encodeSnapshotV1(data, payload), frame);
+    } else {
+      length = frameFor(options, FRAME_DELTA, payload, encodeDeltaV1(data, mask, payload), frame);
+    }
+
+    if (!port.write(frame, length)) {
+      perror("Serial write failed");
+      return 1;
+    }
+    link.onSent(now);
+    sent = data;
+    sinceKeyframe = (sinceKeyframe + 1) % options.keyframeEvery;
+
+    if (options.verbose) {
+      fprintf(stderr, "cpu %u.%u%% %d.%dC  gpu %u.%u%% %d.%dC  ram %u/%u (%u.%u%%)  up %u down %u  "
+              "disk %u/%u  fan %u  vram %u/%u  cores %u  %zu bytes\n",
+              data.cpuLoad / 10, data.cpuLoad % 10, data.cpuTemp / 10, abs(data.cpuTemp % 10),
+              data.gpuLoad / 10, data.gpuLoad % 10, data.gpuTemp / 10, abs(data.gpuTemp % 10),
+              data.ramUsed, data.ramTotal, data.ramPercent / 10, data.ramPercent % 10,
+              data.netUpload, data.netDownload, data.diskRead, data.diskWrite, data.fanRpm,
+              data.vramUsed, data.vramTotal, data.cores.count, length);
+    }
+  }
+
+  if (options.latency) {
+    link.latency().report(stderr);
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "BatchedLcdI2C.h"
+
+// DDRAM start address of each row (16x2 and 20x4 layouts)
+static const uint8_t ROW_OFFSETS[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+static const uint8_t CMD_SET_DDRAM_ADDR = 0x80;
+
+void BatchedLcdI2C::begin(uint32_t busClock) {
+  clock = busClock;
+  Wire.setClock(clock);
+}
+
+void BatchedLcdI2C::writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length) {
+  if (row >= rows || row >= sizeof(ROW_OFFSETS)) {
+    return;
+  }
+
+  queueByte(CMD_SET_DDRAM_ADDR | (ROW_OFFSETS[row] + col), 0);
+  for (uint8_t i = 0; i < length; i++) {
+    queueByte(codes[i], RS);
+  }
+  send();
+}
+
+// One HD44780 byte is two nibbles of three expander writes each: six I2C
+// bytes in total
+void BatchedLcdI2C::queueByte(uint8_t value, uint8_t mode) {
+  if (batchLength + 6 > BATCH_SIZE) {
+    send();
+  }
+  queueNibble((value & 0xF0) | mode);
+  queueNibble(((value << 4) & 0xF0) | mode);
+}
+
+void BatchedLcdI2C::queueNibble(uint8_t bits) {
+  bits |= backlightBit;
+  batch[batchLength++] = bits;  // RS and data settle before enable rises
+  batch[batchLength++] = bits | EN;
+  batch[batchLength++] = bits;
+}
+
+void BatchedLcdI2C::send() {
+  if (batchLength == 0) {
+    return;
+  }
+
+  Wire.beginTransmission(address);
+  Wire.write(batch, batchLength);
+  Wire.endTransmission();
+
+  totalBytes += batchLength;
+  batchLength = 0;
+}
@@ -0,0 +1,60 @@
+/*
+ *  GearPulse - batched HD44780 writes over a PCF8574 I2C backpack
+ *  --------------------------------------
+ *  LiquidCrystal_I2C sends every nibble as separate Wire transactions with
+ *  delays around the enable pulse. Here the expander bytes for a whole run
+ *  of characters (each nibble with enable low, high, then low again, so RS
+ *  and the data lines settle before enable rises) are packed into as few
+ *  transmissions as the Wire buffer allows; at 100-400 kHz each I2C byte already takes longer
+ *  than the HD44780 needs between nibbles, so no extra delays are required.
+ *
+ *  Initialisation, CGRAM uploads and slow commands (clear, home) still go
+ *  through LiquidCrystal_I2C.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class BatchedLcdI2C {
+ public:
+  BatchedLcdI2C(uint8_t address, uint8_t rows) : address(address), rows(rows) {}
+
+  // Call after LiquidCrystal_I2C::init(). The PCF8574 is only rated for
+  // 100 kHz, so faster clocks are the caller's choice for backpacks known to
+  // keep up.
+  void begin(uint32_t busClock = 100000);
+
+  // Mirror of the backlight state, since every expander byte carries it
+  void setBacklight(bool on) { backlightBit = on ? BACKLIGHT : 0; }
+
+  // writeRun() sink for CharFrameBuffer::flush()
+  void writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length);
+
+  uint32_t busClock() const { return clock; }
+  uint32_t bytesWritten() const { return totalBytes; }
+
+ private:
+  static const uint8_t RS = 0x01;
+  static const uint8_t EN = 0x04;
+  static const uint8_t BACKLIGHT = 0x08;
+
+  void queueByte(uint8_t value, uint8_t mode);
+  void queueNibble(uint8_t bits);
+  void send();
+
+  uint8_t address;
+  uint8_t rows;
+  uint8_t backlightBit = BACKLIGHT;
+  uint32_t clock = 100000;
+  uint32_t totalBytes = 0;
+
+#ifdef BUFFER_LENGTH
+  static const uint8_t BATCH_SIZE = BUFFER_LENGTH;
+#else
+  static const uint8_t BATCH_SIZE = 32;
+#endif
+  uint8_t batch[BATCH_SIZE];
+  uint8_t batchLength = 0;
+};
@@ -0,0 +1,381 @@
+#include "BinaryFrame.h"
+
+#include <string.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), nibble table keeps it at 32 bytes
+static const uint16_t CRC16_NIBBLE[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t crc16Update(uint16_t crc, uint8_t b) {
+  crc = (crc << 4) ^ CRC16_NIBBLE[(crc >> 12) ^ (b >> 4)];
+  crc = (crc << 4) ^ CRC16_NIBBLE[(crc >> 12) ^ (b & 0x0F)];
+  return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  while (length--) {
+    crc = crc16Update(crc, *data++);
+  }
+  return crc;
+}
+
+void fillProbePattern(uint8_t* out) {
+  static const uint8_t EDGES[8] = { 0x00, 0xFF, 0x55, 0xAA, 0x0F, 0xF0, 0x01, 0x80 };
+  for (uint8_t i = 0; i < PROBE_SIZE; i++) {
+    out[i] = i < 8 ? EDGES[i] : static_cast<uint8_t>(i * 0x2B + 0x11);
+  }
+}
+
+bool checkProbePattern(const uint8_t* payload, size_t length) {
+  if (length != PROBE_SIZE) {
+    return false;
+  }
+  uint8_t expected[PROBE_SIZE];
+  fillProbePattern(expected);
+  return memcmp(payload, expected, PROBE_SIZE) == 0;
+}
+
+// Little-endian readers; payload bytes are not aligned, so never cast
+static uint16_t readU16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t readU32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void writeU16(uint8_t* p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+static void writeU32(uint8_t* p, uint32_t v) {
+  writeU16(p, v & 0xFFFF);
+  writeU16(p + 2, v >> 16);
+}
+
+bool decodeSnapshotV1(const uint8_t* payload, size_t length, SystemData& out) {
+  if (length < SNAPSHOT_V1_SIZE) {
+    return false;
+  }
+
+  out.cpuLoad = readU16(payload + 0);
+  out.cpuTemp = static_cast<int16_t>(readU16(payload + 2));
+  out.gpuLoad = readU16(payload + 4);
+  out.gpuTemp = static_cast<int16_t>(readU16(payload + 6));
+  out.ramTotal = readU16(payload + 8);
+  out.ramUsed = readU16(payload + 10);
+  out.ramPercent = readU16(payload + 12);
+  out.netUpload = readU32(payload + 14);
+  out.netDownload = readU32(payload + 18);
+  out.datetime.year = readU16(payload + 22);
+  out.datetime.month = payload[24];
+  out.datetime.day = payload[25];
+  out.datetime.hour = payload[26];
+  out.datetime.minute = payload[27];
+  out.datetime.second = payload[28];
+  memcpy(out.datetime.period, payload + 29, 2);
+  out.datetime.period[2] = '\0';
+
+  return true;
+}
+
+bool decodeClockV1(const uint8_t* payload, size_t length, ClockSync& out) {
+  if (length < CLOCK_V1_SIZE) {
+    return false;
+  }
+  out.epoch = readU32(payload + 0);
+  out.millis = readU16(payload + 4);
+  out.offsetMinutes = static_cast<int16_t>(readU16(payload + 6));
+  out.hour12 = payload[8] & CLOCK_FLAG_12H;
+  return out.millis < 1000;
+}
+
+uint8_t encodeClockV1(const ClockSync& sync, uint8_t* payload) {
+  writeU32(payload + 0, sync.epoch);
+  writeU16(payload + 4, sync.millis);
+  writeU16(payload + 6, static_cast<uint16_t>(sync.offsetMinutes));
+  payload[8] = sync.hour12 ? CLOCK_FLAG_12H : 0;
+  return CLOCK_V1_SIZE;
+}
+
+// The snapshot payload lays the first 16 metrics out contiguously in bit order
+constexpr uint8_t snapshotSize(uint8_t bit = 0) {
+  return bit >= 16 ? 0 : metricWireSize(METRICS[bit].type) + snapshotSize(bit + 1);
+}
+static_assert(snapshotSize() == SNAPSHOT_V1_SIZE, "snapshot fields and schema disagree");
+
+bool decodeDeltaV1(const uint8_t* payload, size_t length, SystemData& out, uint16_t& mask) {
+  if (length < 2) {
+    return false;
+  }
+  mask = readU16(payload);
+
+  // Scatter the packed fields into a snapshot image, then reuse its decoder
+  uint8_t image[SNAPSHOT_V1_SIZE] = {0};
+  size_t in = 2;
+  uint8_t offset = 0;
+  for (uint8_t bit = 0; bit < 16; bit++) {
+    uint8_t size = metricWireSize(describeMetric(bit).type);
+    if (mask & (1u << bit)) {
+      if (in + size > length) {
+        return false;
+      }
+      memcpy(image + offset, payload + in, size);
+      in += size;
+    }
+    offset += size;
+  }
+
+  SystemData decoded;
+  decodeSnapshotV1(image, sizeof(image), decoded);
+  copyFields(out, decoded, mask);
+
+  return true;
+}
+
+uint8_t encodeSnapshotV1(const SystemData& data, uint8_t* payload) {
+  writeU16(payload + 0, data.cpuLoad);
+  writeU16(payload + 2, static_cast<uint16_t>(data.cpuTemp));
+  writeU16(payload + 4, data.gpuLoad);
+  writeU16(payload + 6, static_cast<uint16_t>(data.gpuTemp));
+  writeU16(payload + 8, data.ramTotal);
+  writeU16(payload + 10, data.ramUsed);
+  writeU16(payload + 12, data.ramPercent);
+  writeU32(payload + 14, data.netUpload);
+  writeU32(payload + 18, data.netDownload);
+  writeU16(payload + 22, data.datetime.year);
+  payload[24] = data.datetime.month;
+  payload[25] = data.datetime.day;
+  payload[26] = data.datetime.hour;
+  payload[27] = data.datetime.minute;
+  payload[28] = data.datetime.second;
+  memcpy(payload + 29, data.datetime.period, 2);
+  return SNAPSHOT_V1_SIZE;
+}
+
+uint8_t encodeDeltaV1(const SystemData& data, uint16_t mask, uint8_t* payload) {
+  uint8_t image[SNAPSHOT_V1_SIZE];
+  encodeSnapshotV1(data, image);
+
+  writeU16(payload, mask);
+  uint8_t out = 2;
+  uint8_t offset = 0;
+  for (uint8_t bit = 0; bit < 16; bit++) {
+    uint8_t size = metricWireSize(describeMetric(bit).type);
+    if (mask & (1u << bit)) {
+      memcpy(payload + out, image + offset, size);
+      out += size;
+    }
+    offset += size;
+  }
+  return out;
+}
+
+bool decodeMetrics(const uint8_t* payload, size_t length, SystemData& out, FieldMask& mask) {
+  if (length < 4) {
+    return false;
+  }
+  mask = readU32(payload);
+  if (mask & ~FIELD_ALL) {
+    return false;
+  }
+
+  // Decode into a copy so a short payload leaves `out` untouched
+  SystemData decoded = out;
+  size_t in = 4;
+  for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+    if (!(mask & (1ul << i))) {
+      continue;
+    }
+    const MetricDesc& metric = describeMetric(i);
+    uint8_t size = metricWireSize(metric.type);
+    if (metric.type == TYPE_CORES) {
+      if (in >= length || payload[in] > MAX_CORES) {
+        return false;
+      }
+      size = 1 + payload[in];
+    }
+    if (in + size > length) {
+      return false;
+    }
+
+    const uint8_t* p = payload + in;
+    switch (metric.type) {
+      case TYPE_U8:  writeMetric(decoded, i, p[0]); break;
+      case TYPE_U16: writeMetric(decoded, i, readU16(p)); break;
+      case TYPE_I16: writeMetric(decoded, i, static_cast<int16_t>(readU16(p))); break;
+      case TYPE_U32: {
+        uint32_t value = readU32(p);  // writeMetric() takes signed values
+        memcpy(reinterpret_cast<uint8_t*>(&decoded) + metric.offset, &value, sizeof(value));
+        break;
+      }
+      case TYPE_TEXT2: {
+        char* text = reinterpret_cast<char*>(&decoded) + metric.offset;
+        memcpy(text, p, 2);
+        text[2] = '\0';
+        break;
+      }
+      case TYPE_CORES:
+        // Clamped like the JSON path, so both wire formats give the same data
+        memset(&decoded.cores, 0, sizeof(decoded.cores));
+        for (uint8_t core = 0; core < p[0]; core++) {
+          writeCoreLoad(decoded, core, p[1 + core]);
+        }
+        break;
+    }
+    in += size;
+  }
+
+  copyFields(out, decoded, mask);
+  return true;
+}
+
+uint8_t encodeMetrics(const SystemData& data, FieldMask mask, uint8_t* payload) {
+  mask &= FIELD_ALL;
+  writeU32(payload, mask);
+  uint8_t out = 4;
+  for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+    if (!(mask & (1ul << i))) {
+      continue;
+    }
+    const MetricDesc& metric = describeMetric(i);
+    const uint8_t* field = reinterpret_cast<const uint8_t*>(&data) + metric.offset;
+    switch (metric.type) {
+      case TYPE_U8:  payload[out] = field[0]; break;
+      case TYPE_U16:
+      case TYPE_I16: writeU16(payload + out, static_cast<uint16_t>(readMetric(data, i))); break;
+      case TYPE_U32: {
+        uint32_t value;
+        memcpy(&value, field, sizeof(value));
+        writeU32(payload + out, value);
+        break;
+      }
+      case TYPE_TEXT2:
+        memcpy(payload + out, field, 2);
+        break;
+      case TYPE_CORES: {
+        uint8_t count = data.cores.count > MAX_CORES ? MAX_CORES : data.cores.count;
+        payload[out] = count;
+        memcpy(payload + out + 1, data.cores.load, count);
+        out += 1 + count;
+        continue;
+      }
+    }
+    out += metricWireSize(metric.type);
+  }
+  return out;
+}
+
+// Shared by both encoders: `extra` bytes of header extension go before the payload
+static size_t encodeFrameWith(uint8_t kind, const uint8_t* extra, uint8_t extraLength,
+                              const uint8_t* payload, uint8_t length, uint8_t* out) {
+  uint8_t body = extraLength + length;
+  out[0] = FRAME_SYNC;
+  out[1] = FRAME_HEADER_SIZE + body;
+  out[2] = FRAME_VERSION;
+  out[3] = kind;
+  if (extraLength) {
+    memcpy(out + 4, extra, extraLength);
+  }
+  memcpy(out + 4 + extraLength, payload, length);
+
+  uint16_t crc = crc16(out + 1, FRAME_HEADER_SIZE + 1 + body);
+  out[4 + body] = crc & 0xFF;
+  out[5 + body] = crc >> 8;
+  return body + FRAME_OVERHEAD;
+}
+
+size_t encodeFrame(FrameKind kind, const uint8_t* payload, uint8_t length, uint8_t* out) {
+  return encodeFrameWith(kind, nullptr, 0, payload, length, out);
+}
+
+size_t encodeHostFrame(uint8_t host, FrameKind kind, const uint8_t* payload, uint8_t length, uint8_t* out) {
+  return encodeFrameWith(kind | FRAME_FLAG_HOST, &host, 1, payload, length, out);
+}
+
+size_t encodeTaggedFrame(int16_t host, const FrameTag& tag, FrameKind kind, const uint8_t* payload, uint8_t length,
+                         uint8_t* out) {
+  uint8_t extra[1 + FRAME_TAG_SIZE];
+  uint8_t extraLength = 0;
+  uint8_t flags = FRAME_FLAG_SEQ;
+  if (host >= 0) {
+    extra[extraLength++] = static_cast<uint8_t>(host);
+    flags |= FRAME_FLAG_HOST;
+  }
+  writeU32(extra + extraLength, tag.seq);
+  writeU32(extra + extraLength + 4, tag.sentUs);
+  return encodeFrameWith(kind | flags, extra, extraLength + FRAME_TAG_SIZE, payload, length, out);
+}
+
+FrameTag BinaryFrameDecoder::tag() const {
+  const uint8_t* at = buffer + FRAME_HEADER_SIZE + ((flags() & FRAME_FLAG_HOST) ? 1 : 0);
+  FrameTag out = { readU32(at), readU32(at + 4) };
+  return out;
+}
+
+void BinaryFrameDecoder::reset() {
+  state = WAIT_SYNC;
+  length = 0;
+  received = 0;
+}
+
+BinaryFrameDecoder::Result BinaryFrameDecoder::fail(FrameError err) {
+  lastError = err;
+  reset();
+  return FRAME_FAILED;
+}
+
+BinaryFrameDecoder::Result BinaryFrameDecoder::push(uint8_t b) {
+  switch (state) {
+    case WAIT_SYNC:
+      if (b == FRAME_SYNC) {
+        state = WAIT_LENGTH;
+      }
+      return NEED_MORE;
+
+    case WAIT_LENGTH:
+      if (b < FRAME_HEADER_SIZE || b > sizeof(buffer)) {
+        return fail(FRAME_BAD_LENGTH);
+      }
+      length = b;
+      received = 0;
+      crc = crc16Update(0xFFFF, b);
+      state = READ_BODY;
+      return NEED_MORE;
+
+    case READ_BODY:
+      buffer[received++] = b;
+      crc = crc16Update(crc, b);
+      if (received == length) {
+        state = READ_CRC_LO;
+      }
+      return NEED_MORE;
+
+    case READ_CRC_LO:
+      frameCrc = b;
+      state = READ_CRC_HI;
+      return NEED_MORE;
+
+    case READ_CRC_HI:
+      frameCrc |= static_cast<uint16_t>(b) << 8;
+      if (frameCrc != crc) {
+        return fail(FRAME_BAD_CRC);
+      }
+      if (version() != FRAME_VERSION) {
+        return fail(FRAME_BAD_VERSION);
+      }
+      if (length < FRAME_HEADER_SIZE + extraLength()) {
+        return fail(FRAME_BAD_LENGTH);
+      }
+      state = WAIT_SYNC;
+      lastError = FRAME_OK;
+      return FRAME_READY;
+  }
+
+  return NEED_MORE;
+}
@@ -0,0 +1,182 @@
+/*
+ *  GearPulse - binary frame protocol
+ *  --------------------------------------
+ *  Compact alternative to the newline-terminated JSON updates. A frame is:
+ *
+ *    offset  size  field
+ *    0       1     FRAME_SYNC (0xA5, never the first byte of a JSON line)
+ *    1       1     LEN: number of bytes from VERSION to the end of PAYLOAD
+ *    2       1     VERSION (FRAME_VERSION)
+ *    3       1     KIND (FrameKind in the low bits, FrameFlag in the high bits)
+ *    4       1     HOST ID, only present when KIND has FRAME_FLAG_HOST
+ *    4/5     8     TAG, only present when KIND has FRAME_FLAG_SEQ
+ *    4..13   n     PAYLOAD, little-endian, fixed layout per KIND/VERSION
+ *    4+n     2     CRC-16/CCITT-FALSE over LEN..PAYLOAD, little-endian
+ *
+ *  This file has no Arduino dependencies so host tools can share it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "LocalClock.h"
+#include "MetricSchema.h"
+#include "SystemData.h"
+
+const uint8_t FRAME_SYNC = 0xA5;
+const uint8_t FRAME_VERSION = 1;
+const uint8_t FRAME_HEADER_SIZE = 2;   // VERSION + KIND, counted in LEN
+const uint8_t FRAME_MAX_PAYLOAD = 250;
+const uint8_t FRAME_OVERHEAD = 6;      // SYNC + LEN + VERSION + KIND + CRC16
+
+enum FrameKind : uint8_t {
+  FRAME_SNAPSHOT = 0x01,  // Full SystemData snapshot
+  FRAME_DELTA = 0x02,     // Field mask followed by only the masked snapshot fields
+  FRAME_PROBE = 0x03,     // Baud rate test pattern, see fillProbePattern()
+  FRAME_CLOCK = 0x04,     // Wall clock sync, for every host on the display
+  FRAME_METRICS = 0x05    // Field mask over the whole schema, then the masked fields
+};
+
+// High bits of KIND. Unknown kinds are rejected, so older firmware drops
+// flagged frames instead of misreading them.
+enum FrameFlag : uint8_t {
+  FRAME_FLAG_HOST = 0x80,  // one host ID byte precedes the payload
+  FRAME_FLAG_SEQ = 0x40    // a FrameTag precedes the payload (protocol 4)
+};
+const uint8_t FRAME_KIND_MASK = 0x3F;
+
+enum FrameError : uint8_t {
+  FRAME_OK = 0,
+  FRAME_BAD_LENGTH,
+  FRAME_BAD_CRC,
+  FRAME_BAD_VERSION
+};
+
+// Snapshot payload, version 1. Values are the scaled integers of SystemData,
+// so decoding is a straight copy.
+//
+//   offset  type    field        unit
+//   0       uint16  cpuLoad      0.1 %
+//   2       int16   cpuTemp      0.1 degC
+//   4       uint16  gpuLoad      0.1 %
+//   6       int16   gpuTemp      0.1 degC
+//   8       uint16  ramTotal     0.01 GB
+//   10      uint16  ramUsed      0.01 GB
+//   12      uint16  ramPercent   0.1 %
+//   14      uint32  netUpload    bytes/s
+//   18      uint32  netDownload  bytes/s
+//   22      uint16  year
+//   24      uint8   month, day, hour, minute, second
+//   29      char[2] period       "AM", "PM" or NUL-padded
+const uint8_t SNAPSHOT_V1_SIZE = 31;
+
+// Delta payload, version 1: a uint16 mask of SnapshotField bits (the low
+// 16 of MetricSchema.h), then each masked field in bit order with the same
+// encoding it has in the snapshot payload.
+
+// Metrics payload: a uint32 FieldMask, then each masked metric in MetricId
+// order, encoded as its MetricType says (cores: a count byte and that many
+// loads). Covers every metric, so newer hosts send only this, as keyframe
+// and as delta. Unknown mask bits are rejected since their size is unknown.
+const uint8_t METRICS_MAX_SIZE = 4 + SNAPSHOT_V1_SIZE + 2 + 4 + 4 + 2 + 2 + 1 + MAX_CORES;
+
+// Probe payload: a fixed pattern with runs of 0s and 1s, alternating bits and
+// every byte value class, so a marginal baud rate fails the CRC or the compare
+const uint8_t PROBE_SIZE = 64;
+void fillProbePattern(uint8_t* out);
+bool checkProbePattern(const uint8_t* payload, size_t length);
+
+// Clock payload, version 1. Sent now and then instead of the date and time
+// fields of every snapshot; the device keeps time in between.
+//
+//   offset  type    field          unit
+//   0       uint32  epoch          UTC seconds since 1970
+//   4       uint16  millis         ms, 0-999
+//   6       int16   offsetMinutes  local time minus UTC
+//   8       uint8   flags          CLOCK_FLAG_*
+const uint8_t CLOCK_V1_SIZE = 9;
+const uint8_t CLOCK_FLAG_12H = 0x01;
+
+bool decodeClockV1(const uint8_t* payload, size_t length, ClockSync& out);
+uint8_t encodeClockV1(const ClockSync& sync, uint8_t* payload);
+
+// Sequence tag, sent by hosts that measure latency: as the TAG of a binary
+// frame, or as the "seq" and "sent" keys of a JSON object. The device
+// echoes it in @lat with its own receive and draw times.
+//
+//   offset  type    field   unit
+//   0       uint32  seq     counts data frames, so gaps are lost frames
+//   4       uint32  sentUs  host clock when sent, us; echoed unchanged
+struct FrameTag {
+  uint32_t seq;
+  uint32_t sentUs;
+};
+const uint8_t FRAME_TAG_SIZE = 8;
+
+uint16_t crc16Update(uint16_t crc, uint8_t b);
+uint16_t crc16(const uint8_t* data, size_t length);
+
+// Decode a snapshot payload. Longer payloads are accepted so that newer hosts
+// can append fields without breaking older firmware.
+bool decodeSnapshotV1(const uint8_t* payload, size_t length, SystemData& out);
+
+// Decode a delta payload. Only the fields set in `mask` are written to `out`.
+bool decodeDeltaV1(const uint8_t* payload, size_t length, SystemData& out, uint16_t& mask);
+
+// Decode a metrics payload. Only the fields set in `mask` are written to `out`.
+bool decodeMetrics(const uint8_t* payload, size_t length, SystemData& out, FieldMask& mask);
+
+// Encoders for the host side. Payload buffers need SNAPSHOT_V1_SIZE bytes
+// (plus 2 for a delta, METRICS_MAX_SIZE for metrics); each returns the
+// number of payload bytes written.
+uint8_t encodeSnapshotV1(const SystemData& data, uint8_t* payload);
+uint8_t encodeDeltaV1(const SystemData& data, uint16_t mask, uint8_t* payload);
+uint8_t encodeMetrics(const SystemData& data, FieldMask mask, uint8_t* payload);
+
+// Wrap a payload in sync, length, version, kind and CRC. `out` needs
+// `length + FRAME_OVERHEAD` bytes; returns the frame size.
+size_t encodeFrame(FrameKind kind, const uint8_t* payload, uint8_t length, uint8_t* out);
+
+// Same, tagged with a host ID for multi-host displays. `out` needs one more byte.
+size_t encodeHostFrame(uint8_t host, FrameKind kind, const uint8_t* payload, uint8_t length, uint8_t* out);
+
+// Same, with a sequence tag and, unless `host` is negative, a host ID. `out`
+// needs FRAME_TAG_SIZE + 1 more bytes.
+size_t encodeTaggedFrame(int16_t host, const FrameTag& tag, FrameKind kind, const uint8_t* payload, uint8_t length,
+                         uint8_t* out);
+
+// Byte-at-a-time frame decoder, fed from the serial ingest loop
+class BinaryFrameDecoder {
+ public:
+  enum Result { NEED_MORE, FRAME_READY, FRAME_FAILED };
+
+  void reset();
+  bool active() const { return state != WAIT_SYNC; }
+  Result push(uint8_t b);
+
+  uint8_t version() const { return buffer[0]; }
+  FrameKind kind() const { return static_cast<FrameKind>(buffer[1] & FRAME_KIND_MASK); }
+  uint8_t flags() const { return buffer[1] & ~FRAME_KIND_MASK; }
+  uint8_t hostId() const { return (flags() & FRAME_FLAG_HOST) ? buffer[FRAME_HEADER_SIZE] : 0; }
+  bool tagged() const { return flags() & FRAME_FLAG_SEQ; }
+  FrameTag tag() const;  // valid when tagged()
+  const uint8_t* payload() const { return buffer + FRAME_HEADER_SIZE + extraLength(); }
+  uint8_t payloadLength() const { return length - FRAME_HEADER_SIZE - extraLength(); }
+  FrameError error() const { return lastError; }
+
+ private:
+  enum State : uint8_t { WAIT_SYNC, WAIT_LENGTH, READ_BODY, READ_CRC_LO, READ_CRC_HI };
+
+  Result fail(FrameError err);
+  uint8_t extraLength() const { return ((flags() & FRAME_FLAG_HOST) ? 1 : 0) + (tagged() ? FRAME_TAG_SIZE : 0); }
+
+  State state = WAIT_SYNC;
+  FrameError lastError = FRAME_OK;
+  uint8_t length = 0;
+  uint8_t received = 0;
+  uint16_t crc = 0;
+  uint16_t frameCrc = 0;
+  uint8_t buffer[FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD];
+};
@@ -0,0 +1,82 @@
+/*
+ *  GearPulse - character LCD shadow framebuffer
+ *  --------------------------------------
+ *  Pages draw into `cells`; flush() compares them with what the panel is
+ *  known to show and sends only the runs of cells that changed, one cursor
+ *  move per run. Cells hold raw character codes, so CGRAM slot 0 is fine.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+template <uint8_t Cols, uint8_t Rows>
+class CharFrameBuffer {
+ public:
+  static const uint8_t COLS = Cols;
+  static const uint8_t ROWS = Rows;
+
+  CharFrameBuffer() { clear(); invalidate(); }
+
+  // Blank the staging buffer; the panel is untouched until flush()
+  void clear() { memset(cells, ' ', sizeof(cells)); }
+
+  // Forget what the panel shows so the next flush() rewrites every cell
+  void invalidate() { stale = true; }
+
+  void setCell(uint8_t col, uint8_t row, uint8_t code) {
+    if (col < Cols && row < Rows) {
+      cells[row][col] = code;
+    }
+  }
+
+  // Copy text into a row, padding the rest of it with spaces
+  void setLine(uint8_t row, const char* text) {
+    if (row >= Rows) {
+      return;
+    }
+    uint8_t col = 0;
+    while (col < Cols && text[col]) {
+      cells[row][col] = static_cast<uint8_t>(text[col]);
+      col++;
+    }
+    memset(cells[row] + col, ' ', Cols - col);
+  }
+
+  uint8_t cell(uint8_t col, uint8_t row) const { return cells[row][col]; }
+
+  // Send changed runs to `sink`, which must provide
+  // writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length).
+  // Returns the number of cells written.
+  template <class Sink>
+  uint16_t flush(Sink& sink) {
+    uint16_t written = 0;
+
+    for (uint8_t row = 0; row < Rows; row++) {
+      uint8_t col = 0;
+      while (col < Cols) {
+        if (!stale && cells[row][col] == shadow[row][col]) {
+          col++;
+          continue;
+        }
+
+        uint8_t start = col;
+        while (col < Cols && (stale || cells[row][col] != shadow[row][col])) {
+          shadow[row][col] = cells[row][col];
+          col++;
+        }
+        sink.writeRun(start, row, cells[row] + start, col - start);
+        written += col - start;
+      }
+    }
+
+    stale = false;
+    return written;
+  }
+
+ private:
+  uint8_t cells[Rows][Cols];
+  uint8_t shadow[Rows][Cols];
+  bool stale;
+};
@@ -0,0 +1,43 @@
+/*
+ *  GearPulse - display backend interface
+ *  --------------------------------------
+ *  Pages are drawn as a grid of character codes in a CharFrameBuffer. A
+ *  backend knows how to put those cells on a particular panel: codes 0-7
+ *  are the custom glyphs last given to defineGlyph(), everything else is
+ *  the HD44780 character ROM (ASCII, 223 for the degree sign, 0xFF for a
+ *  full block).
+ *
+ *  Character panels write each run as it arrives. Pixel panels rasterise
+ *  runs into a local buffer and send what changed on present().
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class DisplayBackend {
+ public:
+  virtual ~DisplayBackend() {}
+
+  // Character grid the panel shows
+  virtual uint8_t cols() const = 0;
+  virtual uint8_t rows() const = 0;
+
+  // Bring the panel up blank, running the bus at up to `fastClock`
+  virtual void begin(uint32_t fastClock) = 0;
+
+  // Backlight on character panels; the whole display on OLEDs
+  virtual void setBacklight(bool on) = 0;
+
+  // Program custom glyph `slot` (0-7) with 8 rows of 5 pixels, bit 4 leftmost
+  virtual void defineGlyph(uint8_t slot, const uint8_t* bitmap) = 0;
+
+  // writeRun() sink for CharFrameBuffer::flush()
+  virtual void writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length) = 0;
+
+  // Send whatever writeRun() and defineGlyph() left pending
+  virtual void present() {}
+
+  virtual uint32_t busClock() const = 0;
+  virtual uint32_t bytesWritten() const = 0;
+};
@@ -0,0 +1,66 @@
+/*
+ *  GearPulse - single-producer single-consumer event queue
+ *  --------------------------------------
+ *  For handing events from an interrupt handler, or a task on the other
+ *  core, to loop() without locks: only the producer writes `head` and only
+ *  the consumer writes `tail`, and a slot is filled before `head` publishes
+ *  it. mark() lets the consumer stop at the events already pushed, so that
+ *  data the producer published before pushing them is known to be visible.
+ *  Capacity must be a power of two; one slot stays empty to tell full
+ *  from empty.
+ *
+ *  push() is forced inline so that an IRAM interrupt handler calling it
+ *  never jumps into flash.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+template <class T, uint8_t Capacity>
+class EventQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+ public:
+  // Producer side. Returns false, dropping the event, when the queue is full.
+  __attribute__((always_inline)) inline bool push(const T& event) {
+    uint8_t next = (head + 1) & (Capacity - 1);
+    if (next == tail) {
+      return false;
+    }
+    slots[head] = event;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    head = next;
+    return true;
+  }
+
+  // Consumer side
+  bool pop(T& event) { return pop(event, head); }
+
+  // The end of the events pushed so far; whatever the producer wrote before
+  // pushing them is visible once this returns
+  uint8_t mark() const {
+    uint8_t end = head;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return end;
+  }
+
+  // Pop only events from before `end`, a position from mark()
+  bool pop(T& event, uint8_t end) {
+    if (tail == end) {
+      return false;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    event = slots[tail];
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    tail = (tail + 1) & (Capacity - 1);
+    return true;
+  }
+
+  bool empty() const { return tail == head; }
+
+ private:
+  T slots[Capacity];
+  volatile uint8_t head = 0;
+  volatile uint8_t tail = 0;
+};
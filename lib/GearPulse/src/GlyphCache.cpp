@@ -0,0 +1,80 @@
+#include "GlyphCache.h"
+
+void GlyphCache::reset() {
+  for (uint8_t slot = 0; slot < SLOTS; slot++) {
+    slotGlyph[slot] = NO_GLYPH;
+    slotUsed[slot] = 0;
+  }
+  tick = 0;
+}
+
+bool GlyphCache::require(const uint8_t* glyphs, uint8_t count) {
+  if (count > SLOTS) {
+    return false;
+  }
+
+  // Slots stamped with the current tick belong to this page and are pinned.
+  // Start from 1 after a wrap so stale stamps never look pinned.
+  if (++tick == 0) {
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+      slotUsed[slot] = 0;
+    }
+    tick = 1;
+  }
+
+  // First pass: stamp glyphs that are already resident
+  bool missing = false;
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t slot = 0;
+    while (slot < SLOTS && slotGlyph[slot] != glyphs[i]) {
+      slot++;
+    }
+    if (slot < SLOTS) {
+      slotUsed[slot] = tick;
+    } else {
+      missing = true;
+    }
+  }
+  if (!missing) {
+    return true;
+  }
+
+  // Second pass: load the missing ones over the least recently used slots
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t victim = SLOTS;
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+      if (slotGlyph[slot] == glyphs[i]) {
+        victim = SLOTS;
+        break;
+      }
+      if (slotUsed[slot] == tick) {
+        continue;
+      }
+      // Prefer empty slots, then the oldest stamp
+      if (victim == SLOTS ||
+          (slotGlyph[victim] != NO_GLYPH &&
+           (slotGlyph[slot] == NO_GLYPH || slotUsed[slot] < slotUsed[victim]))) {
+        victim = slot;
+      }
+    }
+    if (victim == SLOTS) {
+      continue;  // already resident (or loaded earlier in this pass)
+    }
+
+    slotGlyph[victim] = glyphs[i];
+    slotUsed[victim] = tick;
+    upload(victim, glyphs[i]);
+    uploadCount++;
+  }
+
+  return true;
+}
+
+uint8_t GlyphCache::code(uint8_t glyph) const {
+  for (uint8_t slot = 0; slot < SLOTS; slot++) {
+    if (slotGlyph[slot] == glyph) {
+      return slot;
+    }
+  }
+  return ' ';
+}
@@ -0,0 +1,41 @@
+/*
+ *  GearPulse - CGRAM glyph slot manager
+ *  --------------------------------------
+ *  The HD44780 has 8 user-definable characters. Pages declare which glyphs
+ *  they need; glyphs that are already resident keep their slot, and missing
+ *  ones replace the least recently used glyph that the page does not need.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class GlyphCache {
+ public:
+  static const uint8_t SLOTS = 8;
+  static const uint8_t NO_GLYPH = 0xFF;
+
+  // Called to program a CGRAM slot with the bitmap of a glyph ID
+  typedef void (*UploadFn)(uint8_t slot, uint8_t glyph);
+
+  explicit GlyphCache(UploadFn upload) : upload(upload) { reset(); }
+
+  // Forget all residents, e.g. after the controller was re-initialised
+  void reset();
+
+  // Make every glyph in the list resident. Glyphs needed by the same call are
+  // never evicted by each other. Returns false if more than SLOTS are needed.
+  bool require(const uint8_t* glyphs, uint8_t count);
+
+  // Character code for a resident glyph, or a space if it isn't loaded
+  uint8_t code(uint8_t glyph) const;
+
+  uint16_t uploads() const { return uploadCount; }
+
+ private:
+  UploadFn upload;
+  uint8_t slotGlyph[SLOTS];
+  uint16_t slotUsed[SLOTS];
+  uint16_t tick;
+  uint16_t uploadCount = 0;
+};
@@ -0,0 +1,47 @@
+/*
+ *  GearPulse - fixed-capacity sample history
+ *  --------------------------------------
+ *  Samples are quantized to one byte by the caller, so a few dozen samples
+ *  per metric cost only a few dozen bytes. Appending is O(1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+template <uint8_t Capacity>
+class HistoryRing {
+ public:
+  static const uint8_t CAPACITY = Capacity;
+
+  void clear() {
+    head = 0;
+    count = 0;
+    total = 0;
+  }
+
+  void push(uint8_t sample) {
+    samples[head] = sample;
+    head = (head + 1) % Capacity;
+    if (count < Capacity) {
+      count++;
+    }
+    total++;
+  }
+
+  uint8_t size() const { return count; }
+
+  // Number of samples ever pushed; stable positions for sweep-style plots
+  uint32_t pushed() const { return total; }
+
+  // age 0 is the newest sample; callers must keep age < size()
+  uint8_t fromNewest(uint8_t age) const {
+    return samples[(head + Capacity - 1 - age) % Capacity];
+  }
+
+ private:
+  uint8_t samples[Capacity];
+  uint8_t head = 0;
+  uint8_t count = 0;
+  uint32_t total = 0;
+};
@@ -0,0 +1,355 @@
+#include "JsonStreamParser.h"
+
+#include <string.h>
+
+// Significant digits kept in the mantissa; more precision than any sensor has,
+// and small enough that scaling can't overflow int64
+static const int64_t MANTISSA_LIMIT = 100000000000000LL;  // 1e14
+
+enum NumberPhase : uint8_t { NUMBER_INTEGER, NUMBER_FRACTION, NUMBER_EXPONENT };
+
+static bool isSpace(char c) {
+  return c == ' ' || c == '\t';
+}
+
+static bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+void JsonStreamParser::reset() {
+  state = IDLE;
+  escaped = false;
+  depth = 0;
+  length = 0;
+  pathLength = 0;
+  pathBuffer[0] = '\0';
+  pathHash = JSON_KEY_SEED;
+  textLength = 0;
+  textBuffer[0] = '\0';
+}
+
+int16_t JsonStreamParser::index() const {
+  return depth > 0 && isArray[depth - 1] ? arrayIndex[depth - 1] : -1;
+}
+
+int32_t JsonStreamParser::scaled(int32_t scale) const {
+  int64_t value = scaled64(scale);
+  if (value > INT32_MAX) {
+    return INT32_MAX;
+  }
+  return static_cast<int32_t>(value < -INT32_MAX ? -INT32_MAX : value);
+}
+
+int64_t JsonStreamParser::scaled64(int32_t scale) const {
+  bool minus = negative != (scale < 0);
+  int64_t value = mantissa * (scale < 0 ? -static_cast<int64_t>(scale) : scale);
+
+  if (exponent < 0) {
+    if (exponent < -18) {
+      return 0;
+    }
+    int64_t divisor = 1;
+    for (int16_t e = exponent; e < 0; e++) {
+      divisor *= 10;
+    }
+    value = (value + divisor / 2) / divisor;
+  } else {
+    for (int16_t e = 0; e < exponent && value <= INT64_MAX / 10; e++) {
+      value *= 10;
+    }
+  }
+
+  return minus ? -value : value;
+}
+
+JsonStreamParser::Result JsonStreamParser::fail(JsonError err, bool endOfLine) {
+  lastError = err;
+  state = endOfLine ? IDLE : SKIP_LINE;
+  depth = 0;
+  return PARSE_FAILED;
+}
+
+JsonStreamParser::Result JsonStreamParser::push(char c) {
+  switch (state) {
+    case SKIP_LINE:
+      if (c == '\n' || c == '\r') {
+        state = IDLE;
+      }
+      return NEED_MORE;
+
+    case IDLE:
+      if (c == '{') {
+        reset();
+        openContainer(false);
+        state = OBJECT_KEY;
+        length = 1;
+      }
+      return NEED_MORE;
+
+    default:
+      break;
+  }
+
+  // Objects are sent on one line, so a line end inside one means it was cut short
+  if (c == '\n' || c == '\r') {
+    return fail(JSON_INCOMPLETE, true);
+  }
+  if (++length > JSON_MAX_OBJECT) {
+    return fail(JSON_TOO_LONG, false);
+  }
+  return dispatch(c);
+}
+
+JsonStreamParser::Result JsonStreamParser::dispatch(char c) {
+  switch (state) {
+    case OBJECT_KEY:
+      if (isSpace(c)) {
+        return NEED_MORE;
+      }
+      if (c == '}') {
+        return closeContainer(false);
+      }
+      if (c != '"') {
+        return fail(JSON_BAD_TOKEN, false);
+      }
+      // The key replaces the previous one at this level
+      pathLength = levelStart[depth - 1];
+      pathHash = levelHash[depth - 1];
+      if (pathLength > 0) {
+        if (pathLength + 1 >= JSON_MAX_PATH) {
+          return fail(JSON_BAD_KEY, false);  // no room for the separator and a key
+        }
+        pathBuffer[pathLength++] = '.';
+        pathHash = jsonKeyStep(pathHash, '.');
+      }
+      pathBuffer[pathLength] = '\0';
+      escaped = false;
+      state = KEY;
+      return NEED_MORE;
+
+    case KEY:
+      if (!escaped && c == '\\') {
+        escaped = true;
+        return NEED_MORE;
+      }
+      if (!escaped && c == '"') {
+        state = COLON;
+        return NEED_MORE;
+      }
+      escaped = false;
+      if (pathLength >= JSON_MAX_PATH) {
+        return fail(JSON_BAD_KEY, false);
+      }
+      pathBuffer[pathLength++] = c;
+      pathBuffer[pathLength] = '\0';
+      pathHash = jsonKeyStep(pathHash, c);
+      return NEED_MORE;
+
+    case COLON:
+      if (isSpace(c)) {
+        return NEED_MORE;
+      }
+      if (c != ':') {
+        return fail(JSON_BAD_TOKEN, false);
+      }
+      state = VALUE;
+      return NEED_MORE;
+
+    case VALUE:
+      if (isSpace(c)) {
+        return NEED_MORE;
+      }
+      if (c == '{' || c == '[') {
+        if (!openContainer(c == '[')) {
+          return fail(JSON_TOO_DEEP, false);
+        }
+        state = c == '{' ? OBJECT_KEY : VALUE;
+        return NEED_MORE;
+      }
+      if (c == ']') {
+        return closeContainer(true);  // empty array
+      }
+      if (c == '"') {
+        textLength = 0;
+        textBuffer[0] = '\0';
+        escaped = false;
+        state = STRING;
+        return NEED_MORE;
+      }
+      if (c == '-' || isDigit(c)) {
+        startNumber(c);
+        return NEED_MORE;
+      }
+      if (c == 't' || c == 'f' || c == 'n') {
+        textBuffer[0] = c;
+        textBuffer[1] = '\0';
+        textLength = 1;
+        state = LITERAL;
+        return NEED_MORE;
+      }
+      return fail(JSON_BAD_TOKEN, false);
+
+    case STRING:
+      if (!escaped && c == '\\') {
+        escaped = true;
+        return NEED_MORE;
+      }
+      if (!escaped && c == '"') {
+        valueType = JSON_STRING;
+        emit();
+        state = AFTER_VALUE;
+        return NEED_MORE;
+      }
+      escaped = false;
+      if (textLength < JSON_MAX_TEXT) {
+        textBuffer[textLength++] = c;
+        textBuffer[textLength] = '\0';
+      }
+      return NEED_MORE;
+
+    case NUMBER:
+      if (numberChar(c)) {
+        return NEED_MORE;
+      }
+      if (digits == 0) {
+        return fail(JSON_BAD_TOKEN, false);
+      }
+      exponent += exponentNegative ? -exponentPart : exponentPart;
+      valueType = JSON_NUMBER;
+      emit();
+      state = AFTER_VALUE;
+      return dispatch(c);  // the terminator belongs to the container
+
+    case LITERAL:
+      if (c >= 'a' && c <= 'z') {
+        if (textLength >= 5) {
+          return fail(JSON_BAD_TOKEN, false);
+        }
+        textBuffer[textLength++] = c;
+        textBuffer[textLength] = '\0';
+        return NEED_MORE;
+      }
+      if (!finishLiteral()) {
+        return fail(JSON_BAD_TOKEN, false);
+      }
+      emit();
+      state = AFTER_VALUE;
+      return dispatch(c);
+
+    case AFTER_VALUE:
+      if (isSpace(c)) {
+        return NEED_MORE;
+      }
+      if (c == ',') {
+        if (isArray[depth - 1]) {
+          arrayIndex[depth - 1]++;
+          state = VALUE;
+        } else {
+          state = OBJECT_KEY;
+        }
+        return NEED_MORE;
+      }
+      if (c == '}' || c == ']') {
+        return closeContainer(c == ']');
+      }
+      return fail(JSON_BAD_TOKEN, false);
+
+    default:
+      return fail(JSON_BAD_TOKEN, false);
+  }
+}
+
+bool JsonStreamParser::openContainer(bool array) {
+  if (depth >= JSON_MAX_DEPTH) {
+    return false;
+  }
+  levelStart[depth] = pathLength;  // elements and keys extend the current path
+  levelHash[depth] = pathHash;
+  isArray[depth] = array;
+  arrayIndex[depth] = 0;
+  depth++;
+  return true;
+}
+
+JsonStreamParser::Result JsonStreamParser::closeContainer(bool array) {
+  if (depth == 0 || isArray[depth - 1] != array) {
+    return fail(JSON_BAD_TOKEN, false);
+  }
+  depth--;
+  pathLength = levelStart[depth];
+  pathBuffer[pathLength] = '\0';
+  pathHash = levelHash[depth];
+
+  if (depth == 0) {
+    state = IDLE;
+    return OBJECT_DONE;
+  }
+  state = AFTER_VALUE;
+  return NEED_MORE;
+}
+
+bool JsonStreamParser::startNumber(char c) {
+  mantissa = 0;
+  exponent = 0;
+  exponentPart = 0;
+  exponentNegative = false;
+  negative = c == '-';
+  digits = 0;
+  numberPhase = NUMBER_INTEGER;
+  state = NUMBER;
+  return negative || numberChar(c);
+}
+
+bool JsonStreamParser::numberChar(char c) {
+  if (isDigit(c)) {
+    uint8_t digit = c - '0';
+    if (numberPhase == NUMBER_EXPONENT) {
+      if (exponentPart < 1000) {
+        exponentPart = exponentPart * 10 + digit;
+      }
+    } else if (mantissa < MANTISSA_LIMIT) {
+      mantissa = mantissa * 10 + digit;
+      if (numberPhase == NUMBER_FRACTION) {
+        exponent--;
+      }
+    } else if (numberPhase == NUMBER_INTEGER) {
+      exponent++;  // drop the digit but keep the magnitude
+    }
+    if (digits < 255) {
+      digits++;
+    }
+    return true;
+  }
+  if (c == '.' && numberPhase == NUMBER_INTEGER) {
+    numberPhase = NUMBER_FRACTION;
+    return true;
+  }
+  if ((c == 'e' || c == 'E') && numberPhase != NUMBER_EXPONENT) {
+    numberPhase = NUMBER_EXPONENT;
+    return true;
+  }
+  if ((c == '-' || c == '+') && numberPhase == NUMBER_EXPONENT && exponentPart == 0) {
+    exponentNegative = c == '-';
+    return true;
+  }
+  return false;
+}
+
+bool JsonStreamParser::finishLiteral() {
+  if (strcmp(textBuffer, "true") == 0 || strcmp(textBuffer, "false") == 0) {
+    valueType = JSON_BOOL;
+    valueBool = textBuffer[0] == 't';
+    return true;
+  }
+  if (strcmp(textBuffer, "null") == 0) {
+    valueType = JSON_NULL;
+    return true;
+  }
+  return false;
+}
+
+void JsonStreamParser::emit() {
+  if (onValue) {
+    onValue(*this, context);
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ *  GearPulse - streaming JSON parser
+ *  --------------------------------------
+ *  Consumes one newline-terminated JSON object a byte at a time, so parse
+ *  cost is spread over the bytes as they arrive and no line buffer is
+ *  needed. Every scalar is reported through a callback together with its
+ *  dotted key path ("cpu.load"); containers are never stored.
+ *
+ *  Numbers are converted straight to fixed point without floats. Oversize,
+ *  too deep or malformed objects fail as soon as that is known, and the
+ *  parser then skips to the next newline, which is the frame boundary.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint8_t JSON_MAX_DEPTH = 4;
+const uint8_t JSON_MAX_PATH = 40;     // dotted path of the value being parsed
+const uint8_t JSON_MAX_TEXT = 8;      // string values are truncated to this
+const uint16_t JSON_MAX_OBJECT = 2048;  // bytes; anything longer is not ours
+
+enum JsonError : uint8_t {
+  JSON_OK = 0,
+  JSON_BAD_TOKEN,   // not valid JSON
+  JSON_TOO_DEEP,    // more than JSON_MAX_DEPTH nested containers
+  JSON_TOO_LONG,    // object longer than JSON_MAX_OBJECT
+  JSON_BAD_KEY,     // key path longer than JSON_MAX_PATH
+  JSON_INCOMPLETE   // line ended inside the object
+};
+
+enum JsonType : uint8_t { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING };
+
+// 32-bit FNV-1a of a dotted path. The parser hashes keys as they arrive, so
+// callbacks can switch on pathKey() against jsonPathKey("cpu.load")
+// constants folded at compile time instead of comparing strings.
+const uint32_t JSON_KEY_SEED = 2166136261u;
+constexpr uint32_t jsonKeyStep(uint32_t key, char c) {
+  return (key ^ static_cast<uint8_t>(c)) * 16777619u;
+}
+constexpr uint32_t jsonPathKey(const char* path, uint32_t key = JSON_KEY_SEED) {
+  return *path ? jsonPathKey(path + 1, jsonKeyStep(key, *path)) : key;
+}
+
+class JsonStreamParser {
+ public:
+  enum Result { NEED_MORE, OBJECT_DONE, PARSE_FAILED };
+
+  // Called for each scalar; the parser's accessors describe the value
+  typedef void (*ValueFn)(const JsonStreamParser& parser, void* context);
+
+  explicit JsonStreamParser(ValueFn onValue, void* context = nullptr)
+    : onValue(onValue), context(context) { reset(); }
+
+  void reset();
+
+  // True from the opening '{' until the object is done, and while skipping
+  // the rest of a line after an error
+  bool active() const { return state != IDLE; }
+  bool skipping() const { return state == SKIP_LINE; }
+
+  Result push(char c);
+  JsonError error() const { return lastError; }
+
+  // Value accessors, valid inside the callback
+  const char* path() const { return pathBuffer; }
+  uint32_t pathKey() const { return pathHash; }  // jsonPathKey(path())
+  int16_t index() const;  // position in the innermost array, or -1
+  JsonType type() const { return valueType; }
+  bool boolean() const { return valueBool; }
+  const char* text() const { return textBuffer; }
+
+  // The number times `scale`, rounded half away from zero and saturated
+  int32_t scaled(int32_t scale) const;
+
+  // Same with 64-bit range, e.g. for epoch milliseconds
+  int64_t scaled64(int32_t scale) const;
+
+ private:
+  enum State : uint8_t {
+    IDLE, OBJECT_KEY, KEY, COLON, VALUE, STRING, NUMBER, LITERAL, AFTER_VALUE, SKIP_LINE
+  };
+
+  Result fail(JsonError err, bool endOfLine);
+  bool openContainer(bool array);
+  Result closeContainer(bool array);
+  Result dispatch(char c);
+  bool startNumber(char c);
+  bool numberChar(char c);
+  bool finishLiteral();
+  void emit();
+
+  ValueFn onValue;
+  void* context;
+
+  State state;
+  JsonError lastError = JSON_OK;
+  bool escaped;
+  uint8_t depth;
+  bool isArray[JSON_MAX_DEPTH];
+  int16_t arrayIndex[JSON_MAX_DEPTH];
+  uint8_t levelStart[JSON_MAX_DEPTH];  // path length before each level's key
+  uint32_t levelHash[JSON_MAX_DEPTH];  // and its key hash
+  uint16_t length;
+
+  char pathBuffer[JSON_MAX_PATH + 1];
+  uint8_t pathLength;
+  uint32_t pathHash;
+
+  JsonType valueType;
+  bool valueBool;
+  char textBuffer[JSON_MAX_TEXT + 1];
+  uint8_t textLength;
+
+  // Number being parsed: mantissa * 10^exponent
+  int64_t mantissa;
+  int16_t exponent;
+  int16_t exponentPart;
+  uint8_t numberPhase;
+  bool negative;
+  bool exponentNegative;
+  uint8_t digits;
+};
@@ -0,0 +1,23 @@
+#include "LcdDisplay.h"
+
+#include <string.h>
+
+void LcdDisplay::begin(uint32_t fastClock) {
+  lcd.init();
+  bus.begin(fastClock);
+}
+
+void LcdDisplay::setBacklight(bool on) {
+  if (on) {
+    lcd.backlight();
+  } else {
+    lcd.noBacklight();
+  }
+  bus.setBacklight(on);
+}
+
+void LcdDisplay::defineGlyph(uint8_t slot, const uint8_t* bitmap) {
+  uint8_t rows[8];
+  memcpy(rows, bitmap, sizeof(rows));
+  lcd.createChar(slot, rows);
+}
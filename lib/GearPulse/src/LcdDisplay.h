@@ -0,0 +1,39 @@
+/*
+ *  GearPulse - HD44780 character LCD behind a PCF8574 backpack
+ *  --------------------------------------
+ *  16x2 or 20x4. LiquidCrystal_I2C handles initialisation, CGRAM uploads
+ *  and the backlight; character runs go through BatchedLcdI2C.
+ */
+
+#pragma once
+
+#include <LiquidCrystal_I2C.h>
+
+#include "BatchedLcdI2C.h"
+#include "DisplayBackend.h"
+
+class LcdDisplay : public DisplayBackend {
+ public:
+  LcdDisplay(uint8_t address, uint8_t cols, uint8_t rows)
+      : lcd(address, cols, rows), bus(address, rows), gridCols(cols), gridRows(rows) {}
+
+  uint8_t cols() const override { return gridCols; }
+  uint8_t rows() const override { return gridRows; }
+
+  void begin(uint32_t fastClock) override;
+  void setBacklight(bool on) override;
+  void defineGlyph(uint8_t slot, const uint8_t* bitmap) override;
+
+  void writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length) override {
+    bus.writeRun(col, row, codes, length);
+  }
+
+  uint32_t busClock() const override { return bus.busClock(); }
+  uint32_t bytesWritten() const override { return bus.bytesWritten(); }
+
+ private:
+  LiquidCrystal_I2C lcd;
+  BatchedLcdI2C bus;
+  uint8_t gridCols;
+  uint8_t gridRows;
+};
@@ -0,0 +1,87 @@
+#include "LocalClock.h"
+
+#include <string.h>
+
+static int64_t absolute(int64_t value) {
+  return value < 0 ? -value : value;
+}
+
+static int64_t floorDiv(int64_t value, int64_t divisor) {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+void LocalClock::reset() {
+  synced = false;  // the drift measured so far still applies
+}
+
+void LocalClock::sync(const ClockSync& sync, uint32_t now) {
+  int64_t host = static_cast<int64_t>(sync.epoch) * 1000 + sync.millis;
+
+  if (!synced || absolute(host - utcMs(now)) > CLOCK_STEP_MS) {
+    anchorUtcMs = host;
+    anchorAt = now;
+  } else {
+    uint32_t span = now - anchorAt;
+    if (span >= DRIFT_MIN_SPAN_MS) {
+      int64_t measured = (host - anchorUtcMs - span) * 1000000 / span;
+      if (absolute(measured) <= DRIFT_MAX_PPM) {
+        ppm = static_cast<int32_t>(measured);
+      }
+      // Keep the span short enough that millis() can't wrap across it
+      if (span >= DRIFT_MAX_SPAN_MS || absolute(measured) > DRIFT_MAX_PPM) {
+        anchorUtcMs = host;
+        anchorAt = now;
+      }
+    }
+  }
+
+  baseUtcMs = host;
+  baseAt = now;
+  offsetMinutes = sync.offsetMinutes;
+  hour12 = sync.hour12;
+  synced = true;
+}
+
+int64_t LocalClock::utcMs(uint32_t now) const {
+  uint32_t elapsed = now - baseAt;
+  return baseUtcMs + elapsed + static_cast<int64_t>(elapsed) * ppm / 1000000;
+}
+
+int64_t LocalClock::localSeconds(uint32_t now) const {
+  return floorDiv(utcMs(now), 1000) + static_cast<int64_t>(offsetMinutes) * 60;
+}
+
+bool LocalClock::read(uint32_t now, SystemData& data) const {
+  if (!synced) {
+    return false;
+  }
+  int64_t seconds = localSeconds(now);
+  int64_t days = floorDiv(seconds, 86400);
+  uint32_t secondOfDay = static_cast<uint32_t>(seconds - days * 86400);
+
+  // Civil date from a day count, proleptic Gregorian, in 400-year eras
+  int64_t z = days + 719468;
+  int64_t era = floorDiv(z, 146097);
+  uint32_t dayOfEra = static_cast<uint32_t>(z - era * 146097);
+  uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  uint32_t monthIndex = (5 * dayOfYear + 2) / 153;  // March = 0
+  uint8_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+
+  data.datetime.year = static_cast<uint16_t>(yearOfEra + era * 400 + (month <= 2));
+  data.datetime.month = month;
+  data.datetime.day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+
+  uint8_t hour = secondOfDay / 3600;
+  data.datetime.minute = secondOfDay / 60 % 60;
+  data.datetime.second = secondOfDay % 60;
+  if (hour12) {
+    strcpy(data.datetime.period, hour < 12 ? "AM" : "PM");
+    hour %= 12;
+    data.datetime.hour = hour ? hour : 12;
+  } else {
+    data.datetime.period[0] = '\0';
+    data.datetime.hour = hour;
+  }
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ *  GearPulse - wall clock kept on the device
+ *  --------------------------------------
+ *  The host sends the UTC time now and then; in between, time is counted
+ *  from millis(). The crystal's error is measured by comparing the local
+ *  elapsed time against the host's over a long span (at least
+ *  DRIFT_MIN_SPAN_MS) and corrected as parts per million, so syncs can be
+ *  minutes apart without the seconds visibly slipping.
+ *
+ *  A sync that disagrees with the local count by more than CLOCK_STEP_MS
+ *  is a clock change on the host (DST, manual set), not drift: the clock
+ *  jumps and the drift measurement starts over. Times may wrap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "SystemData.h"
+
+const uint32_t DRIFT_MIN_SPAN_MS = 10UL * 60 * 1000;
+const uint32_t DRIFT_MAX_SPAN_MS = 24UL * 60 * 60 * 1000;
+const int32_t DRIFT_MAX_PPM = 2000;  // worse than any crystal or resonator
+const uint32_t CLOCK_STEP_MS = 5000;
+
+// One sync from the host
+struct ClockSync {
+  uint32_t epoch;         // UTC seconds since 1970
+  uint16_t millis;        // 0-999
+  int16_t offsetMinutes;  // local time = UTC + offset
+  bool hour12;            // show 1-12 with AM/PM instead of 0-23
+};
+
+class LocalClock {
+ public:
+  // Back to unsynced, e.g. after a sleep that stopped millis()
+  void reset();
+
+  void sync(const ClockSync& sync, uint32_t now);
+  bool valid() const { return synced; }
+
+  // Local seconds since 1970 at `now`; only meaningful once valid()
+  int64_t localSeconds(uint32_t now) const;
+
+  // Fill data.datetime with the local date and time at `now`. Returns false,
+  // leaving `data` alone, until the first sync.
+  bool read(uint32_t now, SystemData& data) const;
+
+  int32_t driftPpm() const { return ppm; }
+
+ private:
+  int64_t utcMs(uint32_t now) const;
+
+  bool synced = false;
+  bool hour12 = false;
+  int16_t offsetMinutes = 0;
+  int32_t ppm = 0;
+
+  // Latest sync sets the time; the oldest one in the span sets the rate
+  int64_t baseUtcMs = 0;
+  uint32_t baseAt = 0;
+  int64_t anchorUtcMs = 0;
+  uint32_t anchorAt = 0;
+};
@@ -0,0 +1,113 @@
+#include "MetricSchema.h"
+
+#include <string.h>
+
+static const uint8_t* fieldOf(const SystemData& data, uint8_t metric) {
+  return reinterpret_cast<const uint8_t*>(&data) + METRICS[metric].offset;
+}
+
+static uint8_t* fieldOf(SystemData& data, uint8_t metric) {
+  return reinterpret_cast<uint8_t*>(&data) + METRICS[metric].offset;
+}
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high) {
+  return value < low ? low : value > high ? high : value;
+}
+
+int8_t findMetric(uint32_t key) {
+  for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+    if (METRICS[i].key == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const MetricDesc& describeMetric(uint8_t metric) {
+  return METRICS[metric];
+}
+
+int32_t readMetric(const SystemData& data, uint8_t metric) {
+  const uint8_t* field = fieldOf(data, metric);
+  switch (METRICS[metric].type) {
+    case TYPE_U8:
+      return *field;
+    case TYPE_U16: {
+      uint16_t value;
+      memcpy(&value, field, sizeof(value));
+      return value;
+    }
+    case TYPE_I16: {
+      int16_t value;
+      memcpy(&value, field, sizeof(value));
+      return value;
+    }
+    case TYPE_U32: {
+      uint32_t value;
+      memcpy(&value, field, sizeof(value));
+      return value > INT32_MAX ? INT32_MAX : static_cast<int32_t>(value);
+    }
+    default:
+      return 0;
+  }
+}
+
+void writeMetric(SystemData& data, uint8_t metric, int32_t value) {
+  uint8_t* field = fieldOf(data, metric);
+  switch (METRICS[metric].type) {
+    case TYPE_U8:
+      *field = static_cast<uint8_t>(clamp(value, 0, UINT8_MAX));
+      break;
+    case TYPE_U16: {
+      uint16_t stored = static_cast<uint16_t>(clamp(value, 0, UINT16_MAX));
+      memcpy(field, &stored, sizeof(stored));
+      break;
+    }
+    case TYPE_I16: {
+      int16_t stored = static_cast<int16_t>(clamp(value, INT16_MIN, INT16_MAX));
+      memcpy(field, &stored, sizeof(stored));
+      break;
+    }
+    case TYPE_U32: {
+      uint32_t stored = value < 0 ? 0 : static_cast<uint32_t>(value);
+      memcpy(field, &stored, sizeof(stored));
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void writeCoreLoad(SystemData& data, uint8_t core, int32_t value) {
+  if (core >= MAX_CORES) {
+    return;
+  }
+  data.cores.load[core] = static_cast<uint8_t>(clamp(value, 0, 100 * CORE_SCALE));
+  if (core >= data.cores.count) {
+    data.cores.count = core + 1;
+  }
+}
+
+void copyFields(SystemData& out, const SystemData& in, FieldMask mask) {
+  for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+    if (mask & (1ul << i)) {
+      memcpy(fieldOf(out, i), fieldOf(in, i), metricStorageSize(METRICS[i].type));
+    }
+  }
+}
+
+FieldMask changedFields(const SystemData& before, const SystemData& after) {
+  FieldMask mask = 0;
+  for (uint8_t i = 0; i < METRIC_COUNT; i++) {
+    // Only what is sent counts: the text terminator and loads past the
+    // last core are not
+    uint8_t size = metricWireSize(METRICS[i].type);
+    if (METRICS[i].type == TYPE_CORES) {
+      size = 1 + (after.cores.count > MAX_CORES ? MAX_CORES : after.cores.count);
+    }
+    if (memcmp(fieldOf(before, i), fieldOf(after, i), size) != 0) {
+      mask |= 1ul << i;
+    }
+  }
+  return mask;
+}
@@ -0,0 +1,183 @@
+/*
+ *  GearPulse - metric schema
+ *  --------------------------------------
+ *  One descriptor per SystemData field: its JSON key, where it is stored,
+ *  how it is encoded on the wire, the JSON scale and the display unit. The
+ *  JSON parser, the metrics frame, delta patching and the table-driven
+ *  pages all work from this table, so a new metric is one SystemData
+ *  field, one MetricId and one row here.
+ *
+ *  Keys are compared as jsonPathKey() hashes computed at compile time;
+ *  static_asserts below reject a table where two keys hash alike.
+ *
+ *  This file has no Arduino dependencies so host tools can share it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "JsonStreamParser.h"
+#include "SystemData.h"
+
+// Row order is bit order in field masks. The first 16 are the snapshot
+// fields, in snapshot payload order.
+enum MetricId : uint8_t {
+  METRIC_CPU_LOAD,
+  METRIC_CPU_TEMP,
+  METRIC_GPU_LOAD,
+  METRIC_GPU_TEMP,
+  METRIC_RAM_TOTAL,
+  METRIC_RAM_USED,
+  METRIC_RAM_PERCENT,
+  METRIC_NET_UPLOAD,
+  METRIC_NET_DOWNLOAD,
+  METRIC_YEAR,
+  METRIC_MONTH,
+  METRIC_DAY,
+  METRIC_HOUR,
+  METRIC_MINUTE,
+  METRIC_SECOND,
+  METRIC_PERIOD,
+  METRIC_FAN_RPM,
+  METRIC_DISK_READ,
+  METRIC_DISK_WRITE,
+  METRIC_VRAM_TOTAL,
+  METRIC_VRAM_USED,
+  METRIC_CORES,
+  METRIC_COUNT
+};
+
+// Field mask bits, one per MetricId
+typedef uint32_t FieldMask;
+enum SnapshotField : FieldMask {
+  FIELD_CPU_LOAD     = 1ul << METRIC_CPU_LOAD,
+  FIELD_CPU_TEMP     = 1ul << METRIC_CPU_TEMP,
+  FIELD_GPU_LOAD     = 1ul << METRIC_GPU_LOAD,
+  FIELD_GPU_TEMP     = 1ul << METRIC_GPU_TEMP,
+  FIELD_RAM_TOTAL    = 1ul << METRIC_RAM_TOTAL,
+  FIELD_RAM_USED     = 1ul << METRIC_RAM_USED,
+  FIELD_RAM_PERCENT  = 1ul << METRIC_RAM_PERCENT,
+  FIELD_NET_UPLOAD   = 1ul << METRIC_NET_UPLOAD,
+  FIELD_NET_DOWNLOAD = 1ul << METRIC_NET_DOWNLOAD,
+  FIELD_YEAR         = 1ul << METRIC_YEAR,
+  FIELD_MONTH        = 1ul << METRIC_MONTH,
+  FIELD_DAY          = 1ul << METRIC_DAY,
+  FIELD_HOUR         = 1ul << METRIC_HOUR,
+  FIELD_MINUTE       = 1ul << METRIC_MINUTE,
+  FIELD_SECOND       = 1ul << METRIC_SECOND,
+  FIELD_PERIOD       = 1ul << METRIC_PERIOD,
+  FIELD_FAN_RPM      = 1ul << METRIC_FAN_RPM,
+  FIELD_DISK_READ    = 1ul << METRIC_DISK_READ,
+  FIELD_DISK_WRITE   = 1ul << METRIC_DISK_WRITE,
+  FIELD_VRAM_TOTAL   = 1ul << METRIC_VRAM_TOTAL,
+  FIELD_VRAM_USED    = 1ul << METRIC_VRAM_USED,
+  FIELD_CORES        = 1ul << METRIC_CORES,
+  FIELD_SNAPSHOT     = 0xFFFF,  // everything a snapshot or v1 delta carries
+  FIELD_ALL          = (1ul << METRIC_COUNT) - 1
+};
+
+// Storage and wire encoding. Integers are stored at their own width and
+// sent little-endian at the same width.
+enum MetricType : uint8_t {
+  TYPE_U8,
+  TYPE_U16,
+  TYPE_I16,
+  TYPE_U32,
+  TYPE_TEXT2,  // char[3] stored, 2 chars sent, NUL-padded
+  TYPE_CORES   // count byte, then count one-byte loads
+};
+
+// What a value means, which picks its formatter on the display
+enum MetricUnit : uint8_t {
+  UNIT_NONE,       // plain number: dates, times
+  UNIT_PERCENT10,  // 0.1 %
+  UNIT_CELSIUS10,  // 0.1 degC
+  UNIT_GB100,      // 0.01 GB
+  UNIT_RATE,       // bytes/s
+  UNIT_RPM,
+  UNIT_TEXT,
+  UNIT_PERCENT2    // 0.5 %, per core
+};
+
+struct MetricDesc {
+  uint32_t key;     // jsonPathKey() of the JSON path
+  uint8_t offset;   // offsetof(SystemData, field)
+  MetricType type;
+  uint8_t scale;    // JSON value * scale = stored value
+  MetricUnit unit;
+};
+
+constexpr MetricDesc METRICS[METRIC_COUNT] = {
+  { jsonPathKey("cpu.load"),         offsetof(SystemData, cpuLoad),         TYPE_U16,   LOAD_SCALE, UNIT_PERCENT10 },
+  { jsonPathKey("cpu.temp"),         offsetof(SystemData, cpuTemp),         TYPE_I16,   TEMP_SCALE, UNIT_CELSIUS10 },
+  { jsonPathKey("gpu.load"),         offsetof(SystemData, gpuLoad),         TYPE_U16,   LOAD_SCALE, UNIT_PERCENT10 },
+  { jsonPathKey("gpu.temp"),         offsetof(SystemData, gpuTemp),         TYPE_I16,   TEMP_SCALE, UNIT_CELSIUS10 },
+  { jsonPathKey("ram.total"),        offsetof(SystemData, ramTotal),        TYPE_U16,   RAM_SCALE,  UNIT_GB100 },
+  { jsonPathKey("ram.used"),         offsetof(SystemData, ramUsed),         TYPE_U16,   RAM_SCALE,  UNIT_GB100 },
+  { jsonPathKey("ram.usagePercent"), offsetof(SystemData, ramPercent),      TYPE_U16,   LOAD_SCALE, UNIT_PERCENT10 },
+  { jsonPathKey("network.upload"),   offsetof(SystemData, netUpload),       TYPE_U32,   1,          UNIT_RATE },
+  { jsonPathKey("network.download"), offsetof(SystemData, netDownload),     TYPE_U32,   1,          UNIT_RATE },
+  { jsonPathKey("date.year"),        offsetof(SystemData, datetime.year),   TYPE_U16,   1,          UNIT_NONE },
+  { jsonPathKey("date.month"),       offsetof(SystemData, datetime.month),  TYPE_U8,    1,          UNIT_NONE },
+  { jsonPathKey("date.day"),         offsetof(SystemData, datetime.day),    TYPE_U8,    1,          UNIT_NONE },
+  { jsonPathKey("time.hour"),        offsetof(SystemData, datetime.hour),   TYPE_U8,    1,          UNIT_NONE },
+  { jsonPathKey("time.minute"),      offsetof(SystemData, datetime.minute), TYPE_U8,    1,          UNIT_NONE },
+  { jsonPathKey("time.second"),      offsetof(SystemData, datetime.second), TYPE_U8,    1,          UNIT_NONE },
+  { jsonPathKey("time.period"),      offsetof(SystemData, datetime.period), TYPE_TEXT2, 1,          UNIT_TEXT },
+  { jsonPathKey("fan.rpm"),          offsetof(SystemData, fanRpm),          TYPE_U16,   1,          UNIT_RPM },
+  { jsonPathKey("disk.read"),        offsetof(SystemData, diskRead),        TYPE_U32,   1,          UNIT_RATE },
+  { jsonPathKey("disk.write"),       offsetof(SystemData, diskWrite),       TYPE_U32,   1,          UNIT_RATE },
+  { jsonPathKey("vram.total"),       offsetof(SystemData, vramTotal),       TYPE_U16,   RAM_SCALE,  UNIT_GB100 },
+  { jsonPathKey("vram.used"),        offsetof(SystemData, vramUsed),        TYPE_U16,   RAM_SCALE,  UNIT_GB100 },
+  { jsonPathKey("cpu.cores"),        offsetof(SystemData, cores),           TYPE_CORES, CORE_SCALE, UNIT_PERCENT2 },
+};
+
+// Bytes a metric occupies in SystemData
+constexpr uint8_t metricStorageSize(MetricType type) {
+  return type == TYPE_U8 ? 1 :
+         type == TYPE_U32 ? 4 :
+         type == TYPE_TEXT2 ? 3 :
+         type == TYPE_CORES ? 1 + MAX_CORES : 2;
+}
+
+// Bytes a metric takes on the wire; for TYPE_CORES, with every core present
+constexpr uint8_t metricWireSize(MetricType type) {
+  return type == TYPE_TEXT2 ? 2 : metricStorageSize(type);
+}
+
+constexpr bool metricKeyUnique(uint8_t i, uint8_t j) {
+  return j >= METRIC_COUNT || (METRICS[i].key != METRICS[j].key && metricKeyUnique(i, j + 1));
+}
+constexpr bool metricKeysUnique(uint8_t i = 0) {
+  return i >= METRIC_COUNT || (metricKeyUnique(i, i + 1) && metricKeysUnique(i + 1));
+}
+static_assert(metricKeysUnique(), "two metric keys have the same jsonPathKey()");
+
+constexpr bool metricFits(uint8_t i = 0) {
+  return i >= METRIC_COUNT ||
+         (METRICS[i].offset + metricStorageSize(METRICS[i].type) <= sizeof(SystemData) && metricFits(i + 1));
+}
+static_assert(metricFits(), "a metric row does not match its SystemData field");
+
+// The metric with this jsonPathKey(), or -1
+int8_t findMetric(uint32_t key);
+
+// METRICS[metric], for callers indexing at run time: one shared copy of the
+// table instead of one per translation unit
+const MetricDesc& describeMetric(uint8_t metric);
+
+// Read or store a metric as a scaled integer. Stores saturate to the field's
+// range; TYPE_TEXT2 and TYPE_CORES read as 0 and are not stored.
+int32_t readMetric(const SystemData& data, uint8_t metric);
+void writeMetric(SystemData& data, uint8_t metric, int32_t value);
+
+// Store one core's load, growing the core count to include it
+void writeCoreLoad(SystemData& data, uint8_t core, int32_t value);
+
+// Copy the fields set in `mask` from `in` to `out`
+void copyFields(SystemData& out, const SystemData& in, FieldMask mask);
+
+// Mask of the fields whose values differ
+FieldMask changedFields(const SystemData& before, const SystemData& after);
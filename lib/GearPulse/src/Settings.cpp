@@ -0,0 +1,46 @@
+#include "Settings.h"
+
+#include <string.h>
+
+#include "BinaryFrame.h"
+
+void encodeSettings(const Settings& settings, uint8_t* image) {
+  image[0] = SETTINGS_MAGIC;
+  image[1] = SETTINGS_VERSION;
+  image[2] = settings.mode;
+  image[3] = settings.pages;
+  image[4] = settings.renderRateHz;
+  image[5] = settings.backlight;
+  image[6] = settings.fastBoot ? SETTINGS_FLAG_FAST_BOOT : 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    image[7 + i] = static_cast<uint8_t>(settings.baud >> (8 * i));
+  }
+  uint16_t crc = crc16(image, SETTINGS_SIZE - 2);
+  image[11] = crc & 0xFF;
+  image[12] = crc >> 8;
+}
+
+bool decodeSettings(const uint8_t* image, Settings& out) {
+  uint16_t crc = static_cast<uint16_t>(image[11] | (image[12] << 8));
+  if (image[0] != SETTINGS_MAGIC || image[1] != SETTINGS_VERSION || crc != crc16(image, SETTINGS_SIZE - 2)) {
+    return false;
+  }
+  out.mode = image[2];
+  out.pages = image[3];
+  out.renderRateHz = image[4];
+  out.backlight = image[5];
+  out.fastBoot = image[6] & SETTINGS_FLAG_FAST_BOOT;
+  out.baud = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    out.baud |= static_cast<uint32_t>(image[7 + i]) << (8 * i);
+  }
+  return true;
+}
+
+bool sameSettings(const Settings& a, const Settings& b) {
+  uint8_t imageA[SETTINGS_SIZE];
+  uint8_t imageB[SETTINGS_SIZE];
+  encodeSettings(a, imageA);
+  encodeSettings(b, imageB);
+  return memcmp(imageA, imageB, SETTINGS_SIZE) == 0;
+}
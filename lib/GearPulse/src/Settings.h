@@ -0,0 +1,52 @@
+/*
+ *  GearPulse - persisted settings
+ *  --------------------------------------
+ *  The few preferences that survive a reboot, in a small fixed image with
+ *  a magic byte, a version and a CRC, so a blank or foreign EEPROM sector
+ *  just yields the defaults. The firmware decides where the image lives and
+ *  when it is written; this file only encodes and checks it.
+ *
+ *    offset  type    field
+ *    0       uint8   SETTINGS_MAGIC
+ *    1       uint8   SETTINGS_VERSION
+ *    2       uint8   mode          page shown at power on
+ *    3       uint8   pages         bit n set = page n is in the rotation
+ *    4       uint8   renderRateHz
+ *    5       uint8   backlight     BacklightPolicy
+ *    6       uint8   flags         SETTINGS_FLAG_*
+ *    7       uint32  baud          rate the serial port starts at
+ *    11      uint16  CRC-16/CCITT-FALSE over bytes 0-10
+ *
+ *  This file has no Arduino dependencies so host tools can share it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t SETTINGS_MAGIC = 0x47;  // 'G'
+const uint8_t SETTINGS_VERSION = 1;
+const uint8_t SETTINGS_SIZE = 13;
+const uint8_t SETTINGS_FLAG_FAST_BOOT = 0x01;
+
+enum BacklightPolicy : uint8_t {
+  BACKLIGHT_ALWAYS = 0,  // on whenever the display is powered
+  BACKLIGHT_ACTIVE = 1   // off while no host is reporting
+};
+
+struct Settings {
+  uint8_t mode;
+  uint8_t pages;
+  uint8_t renderRateHz;
+  uint8_t backlight;
+  bool fastBoot;  // skip the splash messages and wait for data straight away
+  uint32_t baud;
+};
+
+void encodeSettings(const Settings& settings, uint8_t* image);
+
+// False (and `out` untouched) if the image is blank, corrupt or from
+// another version. Values are not range-checked here.
+bool decodeSettings(const uint8_t* image, Settings& out);
+
+bool sameSettings(const Settings& a, const Settings& b);
@@ -0,0 +1,316 @@
+#include "Ssd1306Display.h"
+
+#include <string.h>
+
+// Printable ASCII in 5x7, one byte per column with bit 0 at the top, as in
+// the HD44780 character ROM
+static const uint8_t FONT_FIRST = 0x20;
+static const uint8_t FONT_LAST = 0x7E;
+static const uint8_t FONT[FONT_LAST - FONT_FIRST + 1][5] PROGMEM = {
+  { 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+  { 0x00, 0x00, 0x5F, 0x00, 0x00 },  // !
+  { 0x00, 0x07, 0x00, 0x07, 0x00 },  // "
+  { 0x14, 0x7F, 0x14, 0x7F, 0x14 },  // #
+  { 0x24, 0x2A, 0x7F, 0x2A, 0x12 },  // $
+  { 0x23, 0x13, 0x08, 0x64, 0x62 },  // %
+  { 0x36, 0x49, 0x55, 0x22, 0x50 },  // &
+  { 0x00, 0x05, 0x03, 0x00, 0x00 },  // '
+  { 0x00, 0x1C, 0x22, 0x41, 0x00 },  // (
+  { 0x00, 0x41, 0x22, 0x1C, 0x00 },  // )
+  { 0x08, 0x2A, 0x1C, 0x2A, 0x08 },  // *
+  { 0x08, 0x08, 0x3E, 0x08, 0x08 },  // +
+  { 0x00, 0x50, 0x30, 0x00, 0x00 },  // ,
+  { 0x08, 0x08, 0x08, 0x08, 0x08 },  // -
+  { 0x00, 0x60, 0x60, 0x00, 0x00 },  // .
+  { 0x20, 0x10, 0x08, 0x04, 0x02 },  // /
+  { 0x3E, 0x51, 0x49, 0x45, 0x3E },  // 0
+  { 0x00, 0x42, 0x7F, 0x40, 0x00 },  // 1
+  { 0x42, 0x61, 0x51, 0x49, 0x46 },  // 2
+  { 0x21, 0x41, 0x45, 0x4B, 0x31 },  // 3
+  { 0x18, 0x14, 0x12, 0x7F, 0x10 },  // 4
+  { 0x27, 0x45, 0x45, 0x45, 0x39 },  // 5
+  { 0x3C, 0x4A, 0x49, 0x49, 0x30 },  // 6
+  { 0x01, 0x71, 0x09, 0x05, 0x03 },  // 7
+  { 0x36, 0x49, 0x49, 0x49, 0x36 },  // 8
+  { 0x06, 0x49, 0x49, 0x29, 0x1E },  // 9
+  { 0x00, 0x36, 0x36, 0x00, 0x00 },  // :
+  { 0x00, 0x56, 0x36, 0x00, 0x00 },  // ;
+  { 0x08, 0x14, 0x22, 0x41, 0x00 },  // <
+  { 0x14, 0x14, 0x14, 0x14, 0x14 },  // =
+  { 0x00, 0x41, 0x22, 0x14, 0x08 },  // >
+  { 0x02, 0x01, 0x51, 0x09, 0x06 },  // ?
+  { 0x32, 0x49, 0x79, 0x41, 0x3E },  // @
+  { 0x7E, 0x11, 0x11, 0x11, 0x7E },  // A
+  { 0x7F, 0x49, 0x49, 0x49, 0x36 },  // B
+  { 0x3E, 0x41, 0x41, 0x41, 0x22 },  // C
+  { 0x7F, 0x41, 0x41, 0x22, 0x1C },  // D
+  { 0x7F, 0x49, 0x49, 0x49, 0x41 },  // E
+  { 0x7F, 0x09, 0x09, 0x09, 0x01 },  // F
+  { 0x3E, 0x41, 0x49, 0x49, 0x7A },  // G
+  { 0x7F, 0x08, 0x08, 0x08, 0x7F },  // H
+  { 0x00, 0x41, 0x7F, 0x41, 0x00 },  // I
+  { 0x20, 0x40, 0x41, 0x3F, 0x01 },  // J
+  { 0x7F, 0x08, 0x14, 0x22, 0x41 },  // K
+  { 0x7F, 0x40, 0x40, 0x40, 0x40 },  // L
+  { 0x7F, 0x02, 0x0C, 0x02, 0x7F },  // M
+  { 0x7F, 0x04, 0x08, 0x10, 0x7F },  // N
+  { 0x3E, 0x41, 0x41, 0x41, 0x3E },  // O
+  { 0x7F, 0x09, 0x09, 0x09, 0x06 },  // P
+  { 0x3E, 0x41, 0x51, 0x21, 0x5E },  // Q
+  { 0x7F, 0x09, 0x19, 0x29, 0x46 },  // R
+  { 0x46, 0x49, 0x49, 0x49, 0x31 },  // S
+  { 0x01, 0x01, 0x7F, 0x01, 0x01 },  // T
+  { 0x3F, 0x40, 0x40, 0x40, 0x3F },  // U
+  { 0x1F, 0x20, 0x40, 0x20, 0x1F },  // V
+  { 0x3F, 0x40, 0x38, 0x40, 0x3F },  // W
+  { 0x63, 0x14, 0x08, 0x14, 0x63 },  // X
+  { 0x07, 0x08, 0x70, 0x08, 0x07 },  // Y
+  { 0x61, 0x51, 0x49, 0x45, 0x43 },  // Z
+  { 0x00, 0x7F, 0x41, 0x41, 0x00 },  // [
+  { 0x02, 0x04, 0x08, 0x10, 0x20 },  // backslash
+  { 0x00, 0x41, 0x41, 0x7F, 0x00 },  // ]
+  { 0x04, 0x02, 0x01, 0x02, 0x04 },  // ^
+  { 0x40, 0x40, 0x40, 0x40, 0x40 },  // _
+  { 0x00, 0x01, 0x02, 0x04, 0x00 },  // `
+  { 0x20, 0x54, 0x54, 0x54, 0x78 },  // a
+  { 0x7F, 0x48, 0x44, 0x44, 0x38 },  // b
+  { 0x38, 0x44, 0x44, 0x44, 0x20 },  // c
+  { 0x38, 0x44, 0x44, 0x48, 0x7F },  // d
+  { 0x38, 0x54, 0x54, 0x54, 0x18 },  // e
+  { 0x08, 0x7E, 0x09, 0x01, 0x02 },  // f
+  { 0x0C, 0x52, 0x52, 0x52, 0x3E },  // g
+  { 0x7F, 0x08, 0x04, 0x04, 0x78 },  // h
+  { 0x00, 0x44, 0x7D, 0x40, 0x00 },  // i
+  { 0x20, 0x40, 0x44, 0x3D, 0x00 },  // j
+  { 0x7F, 0x10, 0x28, 0x44, 0x00 },  // k
+  { 0x00, 0x41, 0x7F, 0x40, 0x00 },  // l
+  { 0x7C, 0x04, 0x18, 0x04, 0x78 },  // m
+  { 0x7C, 0x08, 0x04, 0x04, 0x78 },  // n
+  { 0x38, 0x44, 0x44, 0x44, 0x38 },  // o
+  { 0x7C, 0x14, 0x14, 0x14, 0x08 },  // p
+  { 0x08, 0x14, 0x14, 0x18, 0x7C },  // q
+  { 0x7C, 0x08, 0x04, 0x04, 0x08 },  // r
+  { 0x48, 0x54, 0x54, 0x54, 0x20 },  // s
+  { 0x04, 0x3F, 0x44, 0x40, 0x20 },  // t
+  { 0x3C, 0x40, 0x40, 0x20, 0x7C },  // u
+  { 0x1C, 0x20, 0x40, 0x20, 0x1C },  // v
+  { 0x3C, 0x40, 0x30, 0x40, 0x3C },  // w
+  { 0x44, 0x28, 0x10, 0x28, 0x44 },  // x
+  { 0x0C, 0x50, 0x50, 0x50, 0x3C },  // y
+  { 0x44, 0x64, 0x54, 0x4C, 0x44 },  // z
+  { 0x00, 0x08, 0x36, 0x41, 0x00 },  // {
+  { 0x00, 0x00, 0x7F, 0x00, 0x00 },  // |
+  { 0x00, 0x41, 0x36, 0x08, 0x00 },  // }
+  { 0x08, 0x04, 0x08, 0x10, 0x08 },  // ~
+};
+
+// ROM codes outside ASCII that the pages use
+static const uint8_t CODE_DEGREE = 223;
+static const uint8_t CODE_FULL_BLOCK = 0xFF;
+static const uint8_t DEGREE[5] = { 0x00, 0x06, 0x09, 0x09, 0x06 };
+
+static const uint8_t CONTROL_COMMANDS = 0x00;
+static const uint8_t CONTROL_DATA = 0x40;
+
+static const uint8_t CMD_DISPLAY_OFF = 0xAE;
+static const uint8_t CMD_DISPLAY_ON = 0xAF;
+static const uint8_t CMD_COLUMN_ADDR = 0x21;
+static const uint8_t CMD_PAGE_ADDR = 0x22;
+
+// 128x64 with the internal charge pump, horizontal addressing so an address
+// window is filled row of pages by row of pages
+static const uint8_t INIT_COMMANDS[] = {
+  CMD_DISPLAY_OFF,
+  0xD5, 0x80,  // clock divide and oscillator
+  0xA8, 0x3F,  // multiplex: 64 rows
+  0xD3, 0x00,  // no display offset
+  0x40,        // start line 0
+  0x8D, 0x14,  // charge pump on
+  0x20, 0x00,  // horizontal addressing
+  0xA1,        // mirror columns,
+  0xC8,        // and rows, as the usual modules are wired
+  0xDA, 0x12,  // alternative COM pins
+  0x81, 0xCF,  // contrast
+  0xD9, 0xF1,  // precharge
+  0xDB, 0x40,  // VCOMH deselect level
+  0xA4,        // show RAM contents
+  0xA6,        // not inverted
+  0x2E,        // no scrolling
+  CMD_DISPLAY_ON
+};
+
+// Data bytes per transmission, after the control byte
+#ifdef BUFFER_LENGTH
+static const uint8_t DATA_CHUNK = BUFFER_LENGTH - 1;
+#else
+static const uint8_t DATA_CHUNK = 31;
+#endif
+
+// Each bit of the low nibble, doubled: 4 pixel rows become 8
+static uint8_t doubleRows(uint8_t nibble) {
+  uint8_t out = 0;
+  for (uint8_t bit = 0; bit < 4; bit++) {
+    if (nibble & (1 << bit)) {
+      out |= 3 << (bit * 2);
+    }
+  }
+  return out;
+}
+
+void Ssd1306Display::begin(uint32_t fastClock) {
+  Wire.begin();
+  clock = 100000;
+  if (fastClock > clock) {
+    Wire.setClock(fastClock);
+    Wire.beginTransmission(address);
+    if (Wire.endTransmission() == 0) {
+      clock = fastClock;
+    } else {
+      Wire.setClock(clock);
+    }
+  }
+
+  sendCommands(INIT_COMMANDS, sizeof(INIT_COMMANDS));
+
+  // The controller's RAM is random at power-up: clear all of it once
+  memset(ram, 0, sizeof(ram));
+  memset(codes, ' ', sizeof(codes));
+  memset(glyphs, 0, sizeof(glyphs));
+  memset(dirtyStart, 0, sizeof(dirtyStart));
+  memset(dirtyEnd, WIDTH, sizeof(dirtyEnd));
+  present();
+}
+
+void Ssd1306Display::setBacklight(bool on) {
+  uint8_t command = on ? CMD_DISPLAY_ON : CMD_DISPLAY_OFF;
+  sendCommands(&command, 1);
+}
+
+void Ssd1306Display::defineGlyph(uint8_t slot, const uint8_t* bitmap) {
+  slot &= 7;
+  if (memcmp(glyphs[slot], bitmap, 8) == 0) {
+    return;
+  }
+  memcpy(glyphs[slot], bitmap, 8);
+
+  // As on the HD44780, cells already showing the slot change with it
+  for (uint8_t row = 0; row < ROWS; row++) {
+    for (uint8_t col = 0; col < COLS; col++) {
+      if (codes[row][col] == slot) {
+        drawCell(col, row);
+      }
+    }
+  }
+}
+
+void Ssd1306Display::writeRun(uint8_t col, uint8_t row, const uint8_t* runCodes, uint8_t length) {
+  if (row >= ROWS) {
+    return;
+  }
+  for (uint8_t i = 0; i < length && col + i < COLS; i++) {
+    codes[row][col + i] = runCodes[i];
+    drawCell(col + i, row);
+  }
+}
+
+// Send the dirty spans. Consecutive pages with the same span share one
+// address window, so a changed cell costs one window for both its pages.
+void Ssd1306Display::present() {
+  uint8_t page = 0;
+  while (page < PAGES) {
+    uint8_t start = dirtyStart[page];
+    uint8_t end = dirtyEnd[page];
+    if (start >= end) {
+      page++;
+      continue;
+    }
+
+    uint8_t last = page;
+    while (last + 1 < PAGES && dirtyStart[last + 1] == start && dirtyEnd[last + 1] == end) {
+      last++;
+    }
+
+    const uint8_t window[] = { CMD_COLUMN_ADDR, start, static_cast<uint8_t>(end - 1), CMD_PAGE_ADDR, page, last };
+    sendCommands(window, sizeof(window));
+
+    uint8_t span = end - start;
+    uint16_t remaining = span * (last - page + 1);
+    uint16_t sent = 0;
+    while (remaining > 0) {
+      uint8_t chunk = remaining < DATA_CHUNK ? remaining : DATA_CHUNK;
+      Wire.beginTransmission(address);
+      Wire.write(CONTROL_DATA);
+      for (uint8_t i = 0; i < chunk; i++, sent++) {
+        Wire.write(ram[page + sent / span][start + sent % span]);
+      }
+      Wire.endTransmission();
+      totalBytes += chunk + 1;
+      remaining -= chunk;
+    }
+
+    for (uint8_t p = page; p <= last; p++) {
+      dirtyStart[p] = dirtyEnd[p] = 0;
+    }
+    page = last + 1;
+  }
+}
+
+// Rasterise one cell into the RAM copy, marking the columns that changed
+void Ssd1306Display::drawCell(uint8_t col, uint8_t row) {
+  uint8_t columns[5];
+  glyphColumns(codes[row][col], columns);
+
+  for (uint8_t half = 0; half < 2; half++) {
+    uint8_t page = row * 2 + half;
+    for (uint8_t dx = 0; dx < 8; dx++) {
+      // One column of gap on the left and two on the right, like the LCD
+      uint8_t bits = dx >= 1 && dx <= 5 ? columns[dx - 1] : 0;
+      uint8_t value = doubleRows(half ? bits >> 4 : bits & 0x0F);
+      uint8_t x = col * 8 + dx;
+      if (ram[page][x] == value) {
+        continue;
+      }
+      ram[page][x] = value;
+      if (dirtyStart[page] >= dirtyEnd[page]) {
+        dirtyStart[page] = x;
+        dirtyEnd[page] = x + 1;
+      } else if (x < dirtyStart[page]) {
+        dirtyStart[page] = x;
+      } else if (x >= dirtyEnd[page]) {
+        dirtyEnd[page] = x + 1;
+      }
+    }
+  }
+}
+
+// Five column bytes for a character code, bit 0 at the top
+void Ssd1306Display::glyphColumns(uint8_t code, uint8_t* columns) const {
+  if (code < 8) {
+    // Custom glyphs are stored as rows, bit 4 leftmost
+    for (uint8_t x = 0; x < 5; x++) {
+      uint8_t bits = 0;
+      for (uint8_t y = 0; y < 8; y++) {
+        if (glyphs[code][y] & (0x10 >> x)) {
+          bits |= 1 << y;
+        }
+      }
+      columns[x] = bits;
+    }
+  } else if (code >= FONT_FIRST && code <= FONT_LAST) {
+    memcpy_P(columns, FONT[code - FONT_FIRST], 5);
+  } else if (code == CODE_DEGREE) {
+    memcpy(columns, DEGREE, 5);
+  } else if (code == CODE_FULL_BLOCK) {
+    memset(columns, 0xFF, 5);
+  } else {
+    memset(columns, 0, 5);
+  }
+}
+
+void Ssd1306Display::sendCommands(const uint8_t* commands, uint8_t length) {
+  Wire.beginTransmission(address);
+  Wire.write(CONTROL_COMMANDS);
+  Wire.write(commands, length);
+  Wire.endTransmission();
+  totalBytes += length + 1;
+}
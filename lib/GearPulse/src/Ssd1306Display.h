@@ -0,0 +1,61 @@
+/*
+ *  GearPulse - SSD1306 128x64 OLED as a 16x4 character panel
+ *  --------------------------------------
+ *  Each cell is 8x16 pixels: the 5x8 glyph, doubled vertically, with the
+ *  same gaps an HD44780 leaves between characters, so the pages look as
+ *  they do on the LCD. A text row covers two of the controller's 8-pixel
+ *  pages.
+ *
+ *  Cells are rasterised into a 1 KB copy of the display RAM. Every byte
+ *  that actually changes widens its page's dirty column span, and present()
+ *  sends only those spans, one address window and a few data transmissions
+ *  per page, instead of the whole buffer.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "DisplayBackend.h"
+
+class Ssd1306Display : public DisplayBackend {
+ public:
+  static const uint8_t WIDTH = 128;
+  static const uint8_t PAGES = 8;  // 8-pixel bands, 64 rows in all
+  static const uint8_t COLS = 16;
+  static const uint8_t ROWS = 4;
+
+  explicit Ssd1306Display(uint8_t address = 0x3C) : address(address) {}
+
+  uint8_t cols() const override { return COLS; }
+  uint8_t rows() const override { return ROWS; }
+
+  void begin(uint32_t fastClock) override;
+  void setBacklight(bool on) override;
+  void defineGlyph(uint8_t slot, const uint8_t* bitmap) override;
+  void writeRun(uint8_t col, uint8_t row, const uint8_t* codes, uint8_t length) override;
+  void present() override;
+
+  uint32_t busClock() const override { return clock; }
+  uint32_t bytesWritten() const override { return totalBytes; }
+
+  // Display RAM byte as it will be after the next present(); bit 0 is the
+  // top pixel of the page
+  uint8_t pixels(uint8_t page, uint8_t x) const { return ram[page][x]; }
+
+ private:
+  void drawCell(uint8_t col, uint8_t row);
+  void glyphColumns(uint8_t code, uint8_t* columns) const;
+  void sendCommands(const uint8_t* commands, uint8_t length);
+
+  uint8_t address;
+  uint32_t clock = 100000;
+  uint32_t totalBytes = 0;
+
+  uint8_t ram[PAGES][WIDTH];
+  uint8_t dirtyStart[PAGES];  // dirty columns are [start, end); empty when equal
+  uint8_t dirtyEnd[PAGES];
+  uint8_t codes[ROWS][COLS];
+  uint8_t glyphs[8][8];
+};
@@ -0,0 +1,44 @@
+/*
+ *  GearPulse - latest metrics reported by the host
+ *  --------------------------------------
+ *  Stored as scaled integers: the ESP8266 has no FPU, so values are
+ *  converted once on ingest and the render path stays integer-only. The
+ *  fields up to datetime mirror the binary snapshot payload field for
+ *  field; MetricSchema.h describes every field for the parsers.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Fixed-point scale factors (stored value = real value * scale)
+const int16_t LOAD_SCALE = 10;   // load and RAM percentage in 0.1 %
+const int16_t TEMP_SCALE = 10;   // temperatures in 0.1 degC
+const int16_t RAM_SCALE = 100;   // RAM sizes in 0.01 GB
+const int16_t CORE_SCALE = 2;    // per-core loads in 0.5 %, so one byte each
+
+const uint8_t MAX_CORES = 32;
+
+struct SystemData {
+  uint16_t cpuLoad;
+  int16_t cpuTemp;
+  uint16_t gpuLoad;
+  int16_t gpuTemp;
+  uint16_t ramTotal, ramUsed, ramPercent;
+  uint32_t netUpload, netDownload;  // bytes/s
+  struct {
+    uint16_t year;
+    uint8_t month, day;
+    uint8_t hour, minute, second;
+    char period[3];  // "AM" or "PM"
+  } datetime;
+
+  // Only in metrics frames and JSON; absent sensors stay 0
+  uint16_t fanRpm;
+  uint32_t diskRead, diskWrite;  // bytes/s
+  uint16_t vramTotal, vramUsed;  // 0.01 GB
+  struct {
+    uint8_t count;
+    uint8_t load[MAX_CORES];  // 0.5 %, 0-200
+  } cores;
+};
@@ -0,0 +1,119 @@
+#include "TextFormat.h"
+
+// Two ASCII digits per value 0-99, so each division by 100 yields two digits
+static constexpr char DIGIT_PAIRS[201] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+// Exclusive upper bound of each unit, the binary shift to reach it, and
+// whether one decimal is shown
+struct RateUnit {
+  uint32_t below;
+  uint8_t shift;
+  char suffix;
+  bool tenths;
+};
+
+static constexpr RateUnit RATE_UNITS[] = {
+  { 1024UL,        0,  'B', false },
+  { 1024UL * 1024, 10, 'K', false },
+  { 0xFFFFFFFFUL,  20, 'M', true  },
+};
+
+uint8_t formatText(char* out, const char* text) {
+  uint8_t length = 0;
+  while (text[length]) {
+    out[length] = text[length];
+    length++;
+  }
+  out[length] = '\0';
+  return length;
+}
+
+uint8_t formatUnsigned(char* out, uint32_t value) {
+  char reversed[10];
+  uint8_t count = 0;
+
+  while (value >= 100) {
+    uint8_t pair = value % 100;
+    value /= 100;
+    reversed[count++] = DIGIT_PAIRS[pair * 2 + 1];
+    reversed[count++] = DIGIT_PAIRS[pair * 2];
+  }
+  if (value >= 10) {
+    reversed[count++] = DIGIT_PAIRS[value * 2 + 1];
+    reversed[count++] = DIGIT_PAIRS[value * 2];
+  } else {
+    reversed[count++] = '0' + value;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    out[i] = reversed[count - 1 - i];
+  }
+  out[count] = '\0';
+  return count;
+}
+
+uint8_t formatPad2(char* out, uint8_t value) {
+  value %= 100;
+  out[0] = DIGIT_PAIRS[value * 2];
+  out[1] = DIGIT_PAIRS[value * 2 + 1];
+  out[2] = '\0';
+  return 2;
+}
+
+uint8_t formatPad4(char* out, uint16_t value) {
+  formatPad2(out, (value / 100) % 100);
+  formatPad2(out + 2, value % 100);
+  return 4;
+}
+
+uint8_t formatPercent10(char* out, uint16_t tenths) {
+  uint8_t length = formatUnsigned(out, tenths / 10);
+  out[length++] = '.';
+  out[length++] = '0' + tenths % 10;
+  out[length++] = '%';
+  out[length] = '\0';
+  return length;
+}
+
+uint8_t formatTemp10(char* out, int16_t tenths) {
+  uint8_t length = 0;
+  int16_t whole = (tenths >= 0 ? tenths + 5 : tenths - 5) / 10;
+  if (whole < 0) {
+    out[length++] = '-';
+    whole = -whole;
+  }
+  length += formatUnsigned(out + length, whole);
+  out[length++] = DEGREE_SYMBOL;
+  out[length++] = 'C';
+  out[length] = '\0';
+  return length;
+}
+
+uint8_t formatRate(char* out, uint32_t bytesPerSec) {
+  uint8_t unit = 0;
+  while (unit < sizeof(RATE_UNITS) / sizeof(RATE_UNITS[0]) - 1 && bytesPerSec >= RATE_UNITS[unit].below) {
+    unit++;
+  }
+  const RateUnit& u = RATE_UNITS[unit];
+
+  uint8_t length;
+  if (u.tenths) {
+    // Round to tenths in units of shift-10 first so the multiply can't overflow
+    uint32_t scaled = bytesPerSec >> (u.shift - 10);
+    uint32_t tenths = (scaled * 10 + 512) >> 10;
+    length = formatUnsigned(out, tenths / 10);
+    out[length++] = '.';
+    out[length++] = '0' + tenths % 10;
+  } else {
+    uint32_t half = u.shift ? (1UL << (u.shift - 1)) : 0;
+    length = formatUnsigned(out, (bytesPerSec + half) >> u.shift);
+  }
+  out[length++] = u.suffix;
+  out[length] = '\0';
+  return length;
+}
@@ -0,0 +1,32 @@
+/*
+ *  GearPulse - heap-free integer formatters for the render path
+ *  --------------------------------------
+ *  Each formatter writes straight into a line buffer, NUL-terminates it and
+ *  returns the number of characters written (terminator not counted), so
+ *  callers can chain them without strlen/strcat passes.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+const char DEGREE_SYMBOL = static_cast<char>(223);  // HD44780 ROM A00
+
+// Copy a NUL-terminated string
+uint8_t formatText(char* out, const char* text);
+
+// Decimal without padding: "0", "42", "4294967295"
+uint8_t formatUnsigned(char* out, uint32_t value);
+
+// Zero-padded to two or four digits, for dates and times
+uint8_t formatPad2(char* out, uint8_t value);
+uint8_t formatPad4(char* out, uint16_t value);
+
+// Tenths of a percent: "12.3%"
+uint8_t formatPercent10(char* out, uint16_t tenths);
+
+// Tenths of a degree, rounded to whole degrees: "45°C"
+uint8_t formatTemp10(char* out, int16_t tenths);
+
+// Bytes per second in binary units: "512B", "12K", "1.5M"
+uint8_t formatRate(char* out, uint32_t bytesPerSec);
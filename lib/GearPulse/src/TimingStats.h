@@ -0,0 +1,40 @@
+/*
+ *  GearPulse - min/avg/max accumulator for durations
+ *  --------------------------------------
+ *  Cheap enough to update on every frame or loop pass: two compares and an
+ *  add. The caller decides the window by calling reset().
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class TimingStats {
+ public:
+  TimingStats() { reset(); }
+
+  void reset() {
+    low = UINT32_MAX;
+    high = 0;
+    sum = 0;
+    samples = 0;
+  }
+
+  void add(uint32_t value) {
+    if (value < low) low = value;
+    if (value > high) high = value;
+    sum += value;
+    samples++;
+  }
+
+  uint32_t count() const { return samples; }
+  uint32_t min() const { return samples ? low : 0; }
+  uint32_t max() const { return high; }
+  uint32_t average() const { return samples ? static_cast<uint32_t>(sum / samples) : 0; }
+
+ private:
+  uint32_t low;
+  uint32_t high;
+  uint64_t sum;
+  uint32_t samples;
+};
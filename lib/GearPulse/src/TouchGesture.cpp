@@ -0,0 +1,89 @@
+#include "TouchGesture.h"
+
+void TouchGesture::reset(bool pressed, uint32_t now) {
+  // A pad already held counts as a press that can't become a gesture
+  state = pressed ? HELD : IDLE;
+  pressedAt = now;
+  releasedAt = now;
+}
+
+Gesture TouchGesture::edge(bool pressed, uint32_t at) {
+  switch (state) {
+    case IDLE:
+      if (pressed) {
+        state = PRESSED;
+        pressedAt = at;
+      }
+      return GESTURE_NONE;
+
+    case PRESSED:
+      if (pressed) {
+        return GESTURE_NONE;
+      }
+      releasedAt = at;
+      if (at - pressedAt >= longPressMs) {
+        state = IDLE;  // held long enough, but poll() wasn't called in time
+        return GESTURE_LONG_PRESS;
+      }
+      // Shorter than the debounce time is a glitch, not a tap
+      if (at - pressedAt < debounceMs) {
+        state = IDLE;
+        return GESTURE_NONE;
+      }
+      if (!doubleTap) {
+        state = TAPPED;
+        return GESTURE_TAP;
+      }
+      state = RELEASED;
+      return GESTURE_NONE;
+
+    case RELEASED:
+      if (!pressed) {
+        return GESTURE_NONE;
+      }
+      if (at - releasedAt < debounceMs) {
+        state = PRESSED;  // a dropout in the middle of one press
+        return GESTURE_NONE;
+      }
+      if (at - releasedAt < doubleTapMs) {
+        state = SECOND_PRESS;
+        return GESTURE_DOUBLE_TAP;
+      }
+      // poll() wasn't called in time; the first tap is still owed
+      state = PRESSED;
+      pressedAt = at;
+      return GESTURE_TAP;
+
+    case TAPPED:
+      if (!pressed) {
+        return GESTURE_NONE;
+      }
+      // The rest of the press just reported, or a new one
+      state = at - releasedAt < debounceMs ? SECOND_PRESS : PRESSED;
+      pressedAt = at;
+      return GESTURE_NONE;
+
+    case SECOND_PRESS:
+    case HELD:
+      if (!pressed) {
+        state = IDLE;
+      }
+      return GESTURE_NONE;
+  }
+  return GESTURE_NONE;
+}
+
+Gesture TouchGesture::poll(uint32_t now) {
+  if (state == PRESSED && now - pressedAt >= longPressMs) {
+    state = HELD;
+    return GESTURE_LONG_PRESS;
+  }
+  if (state == RELEASED && now - releasedAt >= doubleTapMs) {
+    state = IDLE;
+    return GESTURE_TAP;
+  }
+  if (state == TAPPED && now - releasedAt >= debounceMs) {
+    state = IDLE;
+  }
+  return GESTURE_NONE;
+}
@@ -0,0 +1,58 @@
+/*
+ *  GearPulse - touch gesture decoder
+ *  --------------------------------------
+ *  Turns timestamped press/release edges into taps, double-taps and long
+ *  presses. Each gesture is reported as soon as its threshold is crossed:
+ *  a long press while the pad is still held, a double-tap on the second
+ *  press, and a tap once the double-tap window has closed. With double-taps
+ *  turned off there is no window to wait for, so taps come on release.
+ *
+ *  Edges come from edge(); poll() reports the gestures that only need time
+ *  to pass, so call it every loop pass. Times are milliseconds and may wrap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum Gesture : uint8_t { GESTURE_NONE, GESTURE_TAP, GESTURE_DOUBLE_TAP, GESTURE_LONG_PRESS };
+
+class TouchGesture {
+ public:
+  TouchGesture(uint16_t longPressMs, uint16_t doubleTapMs, uint16_t debounceMs)
+    : longPressMs(longPressMs), doubleTapMs(doubleTapMs), debounceMs(debounceMs) {}
+
+  // Forget any gesture in progress; `pressed` is the pad's current level
+  void reset(bool pressed, uint32_t now);
+
+  // Whether a second press can make a double-tap; on by default
+  void setDoubleTap(bool enabled) { doubleTap = enabled; }
+
+  Gesture edge(bool pressed, uint32_t at);
+  Gesture poll(uint32_t now);
+
+  // Level as last reported, so a caller can spot a missed edge
+  bool pressed() const { return state == PRESSED || state == SECOND_PRESS || state == HELD; }
+
+  // A gesture is in progress and may still produce an event
+  bool busy() const { return state != IDLE; }
+
+ private:
+  enum State : uint8_t {
+    IDLE,
+    PRESSED,       // first press, not yet long
+    RELEASED,      // short press over, waiting to see if a second one follows
+    TAPPED,        // tap reported on release, a press this soon is a dropout
+    SECOND_PRESS,  // double-tap reported, waiting for release
+    HELD           // long press reported, waiting for release
+  };
+
+  uint16_t longPressMs;
+  uint16_t doubleTapMs;
+  uint16_t debounceMs;
+  bool doubleTap = true;
+
+  State state = IDLE;
+  uint32_t pressedAt = 0;
+  uint32_t releasedAt = 0;
+};
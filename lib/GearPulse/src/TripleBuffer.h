@@ -0,0 +1,52 @@
+/*
+ *  GearPulse - single-producer single-consumer triple buffer
+ *  --------------------------------------
+ *  Hands the newest value from one core to another without either side
+ *  ever waiting. The producer fills back() and publishes it; the consumer
+ *  takes whatever was published last and reads it from front(). Values
+ *  published in between are replaced, not queued, so a consumer that falls
+ *  behind simply sees fewer, newer values.
+ *
+ *  The three slots are always one each for the producer, the consumer and
+ *  the spare in `shared`; publish() and consume() swap their own slot with
+ *  the spare in a single atomic exchange.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+template <class T>
+class TripleBuffer {
+ public:
+  // Producer side: the slot to fill next
+  T& back() { return slots[backIndex]; }
+
+  // Make back() the newest value and take the spare slot to fill next
+  void publish() {
+    uint32_t previous = __atomic_exchange_n(&shared, backIndex | FRESH, __ATOMIC_ACQ_REL);
+    backIndex = previous & INDEX_MASK;
+  }
+
+  // Consumer side: move to the newest value, if one was published since the
+  // last call; front() is unchanged otherwise
+  bool consume() {
+    if (!(__atomic_load_n(&shared, __ATOMIC_RELAXED) & FRESH)) {
+      return false;
+    }
+    uint32_t previous = __atomic_exchange_n(&shared, frontIndex, __ATOMIC_ACQ_REL);
+    frontIndex = previous & INDEX_MASK;
+    return true;
+  }
+
+  const T& front() const { return slots[frontIndex]; }
+
+ private:
+  static const uint32_t INDEX_MASK = 0x03;
+  static const uint32_t FRESH = 0x04;  // the spare holds an unread value
+
+  T slots[3];
+  uint32_t backIndex = 0;   // producer only
+  uint32_t shared = 1;      // the spare slot, shared by both sides
+  uint32_t frontIndex = 2;  // consumer only
+};
@@ -0,0 +1,109 @@
+/*
+ *  GearPulse - rolling min/max/average over a time window
+ *  --------------------------------------
+ *  O(1) per sample and no sample history. Min and max are kept per bucket
+ *  of WindowMs / Buckets, so old extremes drop out a bucket at a time and
+ *  the window covers the last (Buckets - 1) to Buckets bucket lengths. The
+ *  average is an exponentially weighted moving average with WindowMs as
+ *  its time constant, weighted by the time between samples so a bursty
+ *  host doesn't skew it.
+ *
+ *  Values are the scaled integers of SystemData. Times are milliseconds
+ *  and may wrap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+template <uint32_t WindowMs, uint8_t Buckets>
+class WindowStats {
+ public:
+  static const uint32_t BUCKET_MS = WindowMs / Buckets;
+
+  WindowStats() { reset(); }
+
+  void reset() {
+    for (uint8_t i = 0; i < Buckets; i++) {
+      clearBucket(i);
+    }
+    head = 0;
+    headStart = 0;
+    lastAt = 0;
+    mean = 0;
+    started = false;
+  }
+
+  void add(int32_t value, uint32_t now) {
+    int64_t scaled = static_cast<int64_t>(value) * MEAN_SCALE;
+    if (!started) {
+      started = true;
+      headStart = now;
+      mean = scaled;
+    } else {
+      advance(now);
+      uint32_t dt = now - lastAt;
+      mean += (scaled - mean) * dt / (static_cast<int64_t>(WindowMs) + dt);
+    }
+    lastAt = now;
+    if (value < low[head]) low[head] = value;
+    if (value > high[head]) high[head] = value;
+  }
+
+  // Min and max of the samples still in the window at `now`; false if there
+  // are none, e.g. the host stopped reporting a window ago
+  bool range(uint32_t now, int32_t& outLow, int32_t& outHigh) const {
+    outLow = INT32_MAX;
+    outHigh = INT32_MIN;
+    uint8_t count = live(now);
+    for (uint8_t age = 0; age < count; age++) {
+      uint8_t i = (head + Buckets - age) % Buckets;
+      if (low[i] < outLow) outLow = low[i];
+      if (high[i] > outHigh) outHigh = high[i];
+    }
+    return outLow <= outHigh;
+  }
+
+  // Latest moving average; holds its value while no samples arrive
+  int32_t average() const {
+    int64_t rounded = mean >= 0 ? mean + MEAN_SCALE / 2 : mean - MEAN_SCALE / 2;
+    return static_cast<int32_t>(rounded / MEAN_SCALE);
+  }
+
+ private:
+  static const int64_t MEAN_SCALE = 256;  // fraction bits keep small steps from rounding away
+
+  void clearBucket(uint8_t i) {
+    low[i] = INT32_MAX;
+    high[i] = INT32_MIN;
+  }
+
+  // Open a new bucket for every BUCKET_MS since the current one started
+  void advance(uint32_t now) {
+    for (uint8_t steps = 0; steps < Buckets && now - headStart >= BUCKET_MS; steps++) {
+      headStart += BUCKET_MS;
+      head = (head + 1) % Buckets;
+      clearBucket(head);
+    }
+    if (now - headStart >= BUCKET_MS) {
+      headStart = now;  // quiet for a whole window: every bucket is already clear
+    }
+  }
+
+  // Buckets, newest first, that are still inside the window at `now`
+  uint8_t live(uint32_t now) const {
+    if (!started) {
+      return 0;
+    }
+    uint32_t age = (now - headStart) / BUCKET_MS;
+    return age >= Buckets ? 0 : Buckets - age;
+  }
+
+  int32_t low[Buckets];
+  int32_t high[Buckets];
+  uint8_t head;
+  uint32_t headStart;
+  uint32_t lastAt;
+  int64_t mean;
+  bool started;
+};
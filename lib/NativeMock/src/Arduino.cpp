@@ -0,0 +1,387 @@
+#include "Arduino.h"
+#include "NativeMock.h"
+#include "Ticker.h"
+
+#include <stdarg.h>
+#include <new>
+
+// Simulated time
+
+static uint64_t nowMicros = 0;
+
+unsigned long millis() {
+  return static_cast<unsigned long>(nowMicros / 1000);
+}
+
+unsigned long micros() {
+  return static_cast<unsigned long>(nowMicros);
+}
+
+void mockAdvanceMicros(unsigned long us) {
+  nowMicros += us;
+}
+
+void mockAdvance(unsigned long ms) {
+  // Step a millisecond at a time so periodic Tickers fire at their own times
+  for (unsigned long i = 0; i < ms; i++) {
+    nowMicros += 1000;
+    Ticker::runDue(millis());
+  }
+}
+
+void loop();
+
+void mockRun(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while (static_cast<long>(millis() - end) < 0) {
+    loop();
+    mockAdvance(1);
+  }
+}
+
+void delay(unsigned long ms) {
+  mockAdvance(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+  mockAdvanceMicros(us);
+}
+
+void yield() {}
+
+// Pins
+
+static const uint8_t PIN_COUNT = 18;
+static int pinLevels[PIN_COUNT];
+
+// Pin interrupts run synchronously from mockSetPin(), like an ISR
+// preempting whatever loop() was doing
+struct PinInterrupt {
+  void (*handler)();
+  int mode;
+};
+static PinInterrupt pinInterrupts[PIN_COUNT];
+
+static bool interruptFires(int mode, int from, int to) {
+  switch (mode) {
+    case RISING:  return from == LOW && to == HIGH;
+    case FALLING: return from == HIGH && to == LOW;
+    case CHANGE:  return from != to;
+    default:      return false;
+  }
+}
+
+void mockSetPin(uint8_t pin, int level) {
+  if (pin >= PIN_COUNT) {
+    return;
+  }
+  int previous = pinLevels[pin];
+  pinLevels[pin] = level;
+  const PinInterrupt& interrupt = pinInterrupts[pin];
+  if (interrupt.handler && interruptFires(interrupt.mode, previous, level)) {
+    interrupt.handler();
+  }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < PIN_COUNT ? pinLevels[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  mockSetPin(pin, value);
+}
+
+int analogRead(uint8_t pin) {
+  (void)pin;
+  return 512;
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+  return pin;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode) {
+  if (interrupt < PIN_COUNT) {
+    pinInterrupts[interrupt].handler = handler;
+    pinInterrupts[interrupt].mode = mode;
+  }
+}
+
+void detachInterrupt(uint8_t interrupt) {
+  if (interrupt < PIN_COUNT) {
+    pinInterrupts[interrupt].handler = nullptr;
+  }
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+// Fixed seed so runs are repeatable
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) {
+  (void)seed;
+}
+
+long random(long howBig) {
+  if (howBig <= 0) {
+    return 0;
+  }
+  randomState = randomState * 1103515245u + 12345u;
+  return static_cast<long>((randomState >> 16) % static_cast<uint32_t>(howBig));
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t length = strlen(src);
+  if (size > 0) {
+    size_t copy = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, copy);
+    dst[copy] = '\0';
+  }
+  return length;
+}
+
+// Print and Stream
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t written = 0;
+  while (size--) {
+    written += write(*buffer++);
+  }
+  return written;
+}
+
+size_t Print::print(const __FlashStringHelper* text) {
+  return print(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const String& text) {
+  return print(text.c_str());
+}
+
+size_t Print::print(const char* text) {
+  return write(text);
+}
+
+size_t Print::print(char c) {
+  return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(int value, int base) {
+  return print(static_cast<long>(value), base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(long value, int base) {
+  if (value < 0 && base == 10) {
+    return print('-') + printNumber(0UL - static_cast<unsigned long>(value), base);
+  }
+  return printNumber(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+  return print(buffer);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long value, int base) {
+  if (base < 2) {
+    base = 10;
+  }
+  char buffer[8 * sizeof(long) + 1];
+  char* p = buffer + sizeof(buffer) - 1;
+  *p = '\0';
+  do {
+    uint8_t digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  } while (value);
+  return write(p);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return length > 0 ? write(buffer) : 0;
+}
+
+size_t Print::printf_P(PGM_P format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return length > 0 ? write(buffer) : 0;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  while (count < length && available() > 0) {
+    buffer[count++] = static_cast<char>(read());
+  }
+  return count;
+}
+
+// Serial: a ring for input, a flat log for output
+
+static const size_t RX_STORAGE = 8192;
+static uint8_t rxRing[RX_STORAGE];
+static size_t rxHead = 0;
+static size_t rxCount = 0;
+static size_t rxCapacity = 256;
+static bool rxOverrun = false;
+
+static char txLog[MOCK_SERIAL_LOG + 1];
+static size_t txLength = 0;
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long baud) {
+  rate = baud;
+}
+
+size_t HardwareSerial::setRxBufferSize(size_t size) {
+  rxCapacity = size < RX_STORAGE ? size : RX_STORAGE;
+  return rxCapacity;
+}
+
+bool HardwareSerial::hasOverrun() {
+  bool overrun = rxOverrun;
+  rxOverrun = false;
+  return overrun;
+}
+
+int HardwareSerial::available() {
+  return static_cast<int>(rxCount);
+}
+
+int HardwareSerial::read() {
+  if (rxCount == 0) {
+    return -1;
+  }
+  uint8_t b = rxRing[rxHead];
+  rxHead = (rxHead + 1) % RX_STORAGE;
+  rxCount--;
+  return b;
+}
+
+int HardwareSerial::peek() {
+  return rxCount ? rxRing[rxHead] : -1;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (txLength < MOCK_SERIAL_LOG) {
+    txLog[txLength++] = static_cast<char>(c);
+    txLog[txLength] = '\0';
+  }
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    write(buffer[i]);
+  }
+  return size;
+}
+
+size_t mockSerialFeed(const uint8_t* data, size_t length) {
+  size_t accepted = 0;
+  while (accepted < length && rxCount < rxCapacity) {
+    rxRing[(rxHead + rxCount) % RX_STORAGE] = data[accepted++];
+    rxCount++;
+  }
+  if (accepted < length) {
+    rxOverrun = true;
+  }
+  return accepted;
+}
+
+size_t mockSerialFeed(const char* text) {
+  return mockSerialFeed(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+size_t mockSerialPending() {
+  return rxCount;
+}
+
+const char* mockSerialOutput() {
+  return txLog;
+}
+
+void mockSerialTake(char* out, size_t size) {
+  strlcpy(out, txLog, size);
+  mockSerialClear();
+}
+
+void mockSerialClear() {
+  txLength = 0;
+  txLog[0] = '\0';
+}
+
+EspClass ESP;
+
+// Allocation counter. Only the count is tracked; the firmware is expected
+// to allocate nothing at all once it is running.
+
+static uint32_t allocationCount = 0;
+
+uint32_t mockAllocations() {
+  return allocationCount;
+}
+
+void* operator new(size_t size) {
+  allocationCount++;
+  void* p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+  free(p);
+}
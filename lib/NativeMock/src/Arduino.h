@@ -0,0 +1,196 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 Arduino core
+ *  --------------------------------------
+ *  Just enough of Arduino.h for src/main.cpp to build and run on the host
+ *  for `pio test -e native`. Time is simulated: millis() and micros() only
+ *  move when delay() or mockAdvance() is called, so runs are repeatable
+ *  and the firmware's own timers behave as on the device.
+ *
+ *  Flash strings, PROGMEM and pgm_read_* are plain memory here.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+
+class __FlashStringHelper;
+typedef const char* PGM_P;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PSTR(s) (s)
+#define FPSTR(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t*>(p))
+#define pgm_read_word(p) (*reinterpret_cast<const uint16_t*>(p))
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t*>(p))
+#define pgm_read_ptr(p) (*reinterpret_cast<void* const*>(p))
+
+size_t strlcpy(char* dst, const char* src, size_t size);
+
+// Same as the ESP8266 core: std::min/max, so mixed types fail to compile here too
+using std::min;
+using std::max;
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+
+// NodeMCU pin names
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+#define A0 17
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+void randomSeed(unsigned long seed);
+long random(long howBig);
+long random(long howSmall, long howBig);
+
+class String;
+
+class Print {
+ public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* text) { return text ? write(reinterpret_cast<const uint8_t*>(text), strlen(text)) : 0; }
+
+  size_t print(const __FlashStringHelper* text);
+  size_t print(const String& text);
+  size_t print(const char* text);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = 10);
+  size_t print(int value, int base = 10);
+  size_t print(unsigned int value, int base = 10);
+  size_t print(long value, int base = 10);
+  size_t print(unsigned long value, int base = 10);
+  size_t print(double value, int digits = 2);
+
+  size_t println();
+  template <class T>
+  size_t println(const T& value) { return print(value) + println(); }
+  template <class T>
+  size_t println(const T& value, int format) { return print(value, format) + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  size_t printf_P(PGM_P format, ...) __attribute__((format(printf, 2, 3)));
+
+ private:
+  size_t printNumber(unsigned long value, int base);
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { (void)ms; }
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+};
+
+// Only what the firmware passes around; backed by a fixed buffer so it never
+// shows up in the allocation count
+class String {
+ public:
+  static const size_t CAPACITY = 64;
+
+  String(const char* text = "") { strlcpy(buffer, text ? text : "", sizeof(buffer)); }
+  const char* c_str() const { return buffer; }
+  size_t length() const { return strlen(buffer); }
+
+ private:
+  char buffer[CAPACITY];
+};
+
+// UART0 backed by the mock's input queue and output log (see NativeMock.h).
+// The RX queue has the device's 256-byte default size and reports overruns.
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long baud);
+  void end() {}
+  void flush() {}
+  void updateBaudRate(unsigned long baud) { rate = baud; }
+  unsigned long baudRate() const { return rate; }
+  size_t setRxBufferSize(size_t size);
+  bool hasOverrun();
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() { return 128; }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  operator bool() const { return true; }
+
+ private:
+  unsigned long rate = 0;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+ public:
+  uint32_t getFreeHeap() { return 40000; }
+  uint8_t getHeapFragmentation() { return 0; }
+  uint32_t getMaxFreeBlockSize() { return 40000; }
+  uint32_t getCycleCount() { return micros() * 80; }
+  void restart() {}
+  void deepSleep(uint64_t us) { (void)us; }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,54 @@
+#include "EEPROM.h"
+#include "NativeMock.h"
+
+#include <string.h>
+
+static const size_t SECTOR_SIZE = 4096;
+static uint8_t flash[SECTOR_SIZE];
+static uint8_t ram[SECTOR_SIZE];
+static bool flashInitialized = false;
+static uint32_t commits = 0;
+
+EEPROMClass EEPROM;
+
+void mockEepromErase() {
+  memset(flash, 0xFF, sizeof(flash));
+  flashInitialized = true;
+}
+
+uint32_t mockEepromCommits() {
+  return commits;
+}
+
+void EEPROMClass::begin(size_t requested) {
+  if (!flashInitialized) {
+    mockEepromErase();
+  }
+  size = requested < SECTOR_SIZE ? requested : SECTOR_SIZE;
+  memcpy(ram, flash, size);
+}
+
+uint8_t EEPROMClass::read(int address) {
+  return address >= 0 && static_cast<size_t>(address) < size ? ram[address] : 0;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address >= 0 && static_cast<size_t>(address) < size) {
+    ram[address] = value;
+  }
+}
+
+bool EEPROMClass::commit() {
+  if (!size) {
+    return false;
+  }
+  memcpy(flash, ram, size);
+  commits++;  // one sector erase on the device
+  return true;
+}
+
+bool EEPROMClass::end() {
+  bool ok = commit();
+  size = 0;
+  return ok;
+}
@@ -0,0 +1,26 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 EEPROM emulation
+ *  --------------------------------------
+ *  As on the device, begin() copies the flash sector into RAM, writes only
+ *  change the RAM copy and commit() writes it back. The sector outlives a
+ *  second setup(), so tests can reboot into saved settings.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class EEPROMClass {
+ public:
+  void begin(size_t size);
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit();
+  bool end();
+
+ private:
+  size_t size = 0;
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,31 @@
+/*
+ *  GearPulse - native stand-in for ESP8266WiFi
+ *  --------------------------------------
+ *  The radio is only switched between modes; it never connects.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+enum WiFiMode_t { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 };
+enum WiFiSleepType_t { WIFI_NONE_SLEEP = 0, WIFI_LIGHT_SLEEP = 1, WIFI_MODEM_SLEEP = 2 };
+enum wl_status_t { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 };
+
+class ESP8266WiFiClass {
+ public:
+  void persistent(bool persist) { (void)persist; }
+  bool mode(WiFiMode_t newMode) { current = newMode; return true; }
+  WiFiMode_t getMode() const { return current; }
+  bool setSleepMode(WiFiSleepType_t type, uint8_t listenInterval = 0) { (void)listenInterval; sleepType = type; return true; }
+  WiFiSleepType_t getSleepMode() const { return sleepType; }
+  wl_status_t begin(const char* ssid, const char* passphrase = nullptr) { (void)ssid; (void)passphrase; return WL_DISCONNECTED; }
+  bool disconnect(bool wifiOff = false) { if (wifiOff) current = WIFI_OFF; return true; }
+  wl_status_t status() const { return WL_DISCONNECTED; }
+
+ private:
+  WiFiMode_t current = WIFI_OFF;
+  WiFiSleepType_t sleepType = WIFI_NONE_SLEEP;
+};
+
+extern ESP8266WiFiClass WiFi;
@@ -0,0 +1,68 @@
+#include "LiquidCrystal_I2C.h"
+#include "Wire.h"
+
+static const uint8_t ROW_OFFSETS[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+void LiquidCrystal_I2C::init() {
+  Wire.begin();
+  begin(cols, rows);
+}
+
+void LiquidCrystal_I2C::begin(uint8_t newCols, uint8_t newRows, uint8_t charsize) {
+  (void)charsize;
+  cols = newCols;
+  rows = newRows;
+  command(0x28);  // 4-bit, two lines, 5x8
+  command(0x0C);  // display on, no cursor
+  clear();
+  command(0x06);  // increment, no shift
+}
+
+void LiquidCrystal_I2C::clear() {
+  command(0x01);
+}
+
+void LiquidCrystal_I2C::home() {
+  command(0x02);
+}
+
+void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row) {
+  if (row >= rows) {
+    row = rows - 1;
+  }
+  command(0x80 | (col + ROW_OFFSETS[row & 3]));
+}
+
+void LiquidCrystal_I2C::createChar(uint8_t location, uint8_t charmap[]) {
+  command(0x40 | ((location & 7) << 3));
+  for (uint8_t i = 0; i < 8; i++) {
+    write(charmap[i]);
+  }
+}
+
+void LiquidCrystal_I2C::backlight() {
+  backlightBit = BACKLIGHT;
+  Wire.beginTransmission(address);
+  Wire.write(backlightBit);
+  Wire.endTransmission();
+}
+
+void LiquidCrystal_I2C::noBacklight() {
+  backlightBit = 0;
+  Wire.beginTransmission(address);
+  Wire.write(backlightBit);
+  Wire.endTransmission();
+}
+
+void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
+  writeNibble((value & 0xF0) | mode);
+  writeNibble(((value << 4) & 0xF0) | mode);
+}
+
+void LiquidCrystal_I2C::writeNibble(uint8_t bits) {
+  Wire.beginTransmission(address);
+  Wire.write(bits | backlightBit);
+  Wire.write(bits | backlightBit | EN);
+  Wire.write(bits | backlightBit);
+  Wire.endTransmission();
+}
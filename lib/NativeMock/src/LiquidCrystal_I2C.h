@@ -0,0 +1,47 @@
+/*
+ *  GearPulse - native stand-in for LiquidCrystal_I2C
+ *  --------------------------------------
+ *  Same interface as marcoschwartz/LiquidCrystal_I2C. Commands and data go
+ *  out as expander nibbles over Wire like the real library, minus the
+ *  delays, so the panel model sees the same traffic.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class LiquidCrystal_I2C : public Print {
+ public:
+  LiquidCrystal_I2C(uint8_t address, uint8_t cols, uint8_t rows)
+    : address(address), cols(cols), rows(rows) {}
+
+  void init();
+  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = 0);
+
+  void clear();
+  void home();
+  void setCursor(uint8_t col, uint8_t row);
+  void createChar(uint8_t location, uint8_t charmap[]);
+
+  void display() { command(0x0C); }
+  void noDisplay() { command(0x08); }
+  void backlight();
+  void noBacklight();
+
+  void command(uint8_t value) { send(value, 0); }
+  size_t write(uint8_t value) override { send(value, RS); return 1; }
+  using Print::write;
+
+ private:
+  static const uint8_t RS = 0x01;
+  static const uint8_t EN = 0x04;
+  static const uint8_t BACKLIGHT = 0x08;
+
+  void send(uint8_t value, uint8_t mode);
+  void writeNibble(uint8_t bits);
+
+  uint8_t address;
+  uint8_t cols;
+  uint8_t rows;
+  uint8_t backlightBit = BACKLIGHT;
+};
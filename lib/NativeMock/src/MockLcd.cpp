@@ -0,0 +1,100 @@
+#include "MockLcd.h"
+
+#include <string.h>
+
+static const uint8_t CMD_CLEAR = 0x01;
+static const uint8_t CMD_HOME = 0x02;
+static const uint8_t CMD_SET_CGRAM_ADDR = 0x40;
+static const uint8_t CMD_SET_DDRAM_ADDR = 0x80;
+
+static const uint8_t ROW_OFFSETS[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+MockLcd mockLcd;
+
+void MockLcd::reset() {
+  memset(ddram, ' ', sizeof(ddram));
+  memset(cgram, 0, sizeof(cgram));
+  address = 0;
+  cgramSelected = false;
+  highNibble = true;
+  pending = 0;
+  lastBits = 0;
+  backlightOn = false;
+  clearCounters();
+}
+
+void MockLcd::expanderWrite(uint8_t bits) {
+  busBytesCount++;
+  backlightOn = bits & BACKLIGHT;
+  if ((lastBits & EN) && !(bits & EN)) {
+    latch(lastBits);
+  } else if (!(lastBits & EN) && (bits & EN) && ((lastBits ^ bits) & (0xF0 | RS))) {
+    setupCount++;
+  }
+  lastBits = bits;
+}
+
+void MockLcd::latch(uint8_t bits) {
+  uint8_t nibble = bits & 0xF0;
+  if (highNibble) {
+    pending = nibble;
+    highNibble = false;
+    return;
+  }
+  highNibble = true;
+  execute(pending | (nibble >> 4), bits & RS);
+}
+
+void MockLcd::execute(uint8_t value, bool data) {
+  if (data) {
+    if (cgramSelected) {
+      cgram[address & 0x3F] = value & 0x1F;
+      address = (address + 1) & 0x3F;
+      return;
+    }
+    ddram[address & 0x7F] = value;
+    cellsCount++;
+    // DDRAM wraps from the end of one line to the start of the other
+    address = (address + 1) & 0x7F;
+    if (address == 0x28) {
+      address = 0x40;
+    } else if (address == 0x68) {
+      address = 0x00;
+    }
+    return;
+  }
+
+  commandCount++;
+  if (value & CMD_SET_DDRAM_ADDR) {
+    address = value & 0x7F;
+    cgramSelected = false;
+  } else if (value & CMD_SET_CGRAM_ADDR) {
+    address = value & 0x3F;
+    cgramSelected = true;
+  } else if (value == CMD_CLEAR) {
+    memset(ddram, ' ', sizeof(ddram));
+    address = 0;
+    cgramSelected = false;
+  } else if ((value & 0xFE) == CMD_HOME) {
+    address = 0;
+    cgramSelected = false;
+  }
+}
+
+uint8_t MockLcd::cell(uint8_t col, uint8_t row) const {
+  return ddram[(ROW_OFFSETS[row & 3] + col) & 0x7F];
+}
+
+void MockLcd::rowText(uint8_t row, uint8_t cols, char* out) const {
+  for (uint8_t col = 0; col < cols; col++) {
+    uint8_t code = cell(col, row);
+    if (code < 8) {
+      out[col] = '0' + code;
+    } else if (code < 0x20 || code > 0x7E) {
+      out[col] = '#';
+    } else {
+      out[col] = static_cast<char>(code);
+    }
+  }
+  out[cols] = '\0';
+}
@@ -0,0 +1,69 @@
+/*
+ *  GearPulse - HD44780 model behind a PCF8574 backpack
+ *  --------------------------------------
+ *  Decodes the expander bytes sent over Wire exactly as the panel would:
+ *  a nibble is latched on each enable falling edge, two nibbles make a
+ *  command (RS low) or a data byte (RS high). Both LiquidCrystal_I2C and
+ *  BatchedLcdI2C end up here, so tests see the real screen contents and
+ *  count the bus traffic and cells that reached the panel. Writes that raise
+ *  enable while also changing RS or the data lines are counted too, since
+ *  the real controller needs them stable first.
+ *
+ *  The panel is assumed to be in 4-bit mode with increment entry mode, which
+ *  is what LiquidCrystal_I2C::init() leaves it in.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class MockLcd {
+ public:
+  MockLcd() { reset(); }
+
+  void reset();
+
+  // One byte written to the expander
+  void expanderWrite(uint8_t bits);
+
+  // Character code shown at a position of a 16x2 or 20x4 panel
+  uint8_t cell(uint8_t col, uint8_t row) const;
+
+  // Row as printable text: CGRAM codes 0-7 become '0'-'7' and anything else
+  // outside ASCII becomes '#'. `out` needs cols + 1 bytes.
+  void rowText(uint8_t row, uint8_t cols, char* out) const;
+
+  const uint8_t* glyph(uint8_t slot) const { return cgram + (slot & 7) * 8; }
+  bool backlight() const { return backlightOn; }
+
+  // Traffic since reset() or clearCounters()
+  uint32_t busBytes() const { return busBytesCount; }
+  uint32_t cellsWritten() const { return cellsCount; }
+  uint32_t commands() const { return commandCount; }
+  uint32_t setupViolations() const { return setupCount; }
+  void clearCounters() { busBytesCount = cellsCount = commandCount = setupCount = 0; }
+
+ private:
+  static const uint8_t RS = 0x01;
+  static const uint8_t EN = 0x04;
+  static const uint8_t BACKLIGHT = 0x08;
+
+  void latch(uint8_t bits);
+  void execute(uint8_t value, bool data);
+
+  uint8_t ddram[0x80];  // row 0 at 0x00-0x27, row 1 at 0x40-0x67
+  uint8_t cgram[64];
+  uint8_t address;
+  bool cgramSelected;
+  bool highNibble;
+  uint8_t pending;
+  uint8_t lastBits;
+  bool backlightOn;
+
+  uint32_t busBytesCount;
+  uint32_t cellsCount;
+  uint32_t commandCount;
+  uint32_t setupCount;
+};
+
+extern MockLcd mockLcd;
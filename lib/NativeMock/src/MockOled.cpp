@@ -0,0 +1,92 @@
+#include "MockOled.h"
+
+#include <string.h>
+
+MockOled mockOled;
+
+// Parameter bytes following each command the firmware uses
+static uint8_t parameterCount(uint8_t command) {
+  switch (command) {
+    case 0x21:  // column address
+    case 0x22:  // page address
+      return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8:
+    case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+void MockOled::reset() {
+  memset(gddram, 0, sizeof(gddram));
+  colStart = col = 0;
+  colEnd = WIDTH - 1;
+  pageStart = page = 0;
+  pageEnd = PAGES - 1;
+  on = false;
+  expectControl = true;
+  dataMode = false;
+  singleByte = false;
+  paramsWanted = 0;
+  paramCount = 0;
+  clearCounters();
+}
+
+void MockOled::startTransmission() {
+  expectControl = true;
+}
+
+void MockOled::write(uint8_t value) {
+  busBytesCount++;
+  if (expectControl) {
+    singleByte = value & 0x80;
+    dataMode = value & 0x40;
+    expectControl = false;
+    return;
+  }
+
+  if (dataMode) {
+    data(value);
+  } else {
+    command(value);
+  }
+  if (singleByte) {
+    expectControl = true;
+  }
+}
+
+void MockOled::command(uint8_t value) {
+  if (paramsWanted > 0) {
+    params[paramCount++] = value;
+    if (--paramsWanted > 0) {
+      return;
+    }
+    if (command0 == 0x21) {
+      colStart = col = params[0] & 0x7F;
+      colEnd = params[1] & 0x7F;
+    } else if (command0 == 0x22) {
+      pageStart = page = params[0] & 7;
+      pageEnd = params[1] & 7;
+    }
+    return;
+  }
+
+  command0 = value;
+  paramCount = 0;
+  paramsWanted = parameterCount(value);
+  if (value == 0xAE || value == 0xAF) {
+    on = value == 0xAF;
+  }
+}
+
+void MockOled::data(uint8_t value) {
+  dataBytesCount++;
+  gddram[page][col] = value;
+  if (col < colEnd) {
+    col++;
+    return;
+  }
+  col = colStart;
+  page = page < pageEnd ? page + 1 : pageStart;
+}
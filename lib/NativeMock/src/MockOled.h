@@ -0,0 +1,59 @@
+/*
+ *  GearPulse - SSD1306 model on the I2C bus
+ *  --------------------------------------
+ *  Decodes transmissions to 0x3C/0x3D as the controller would: a control
+ *  byte picks commands or display data, the column and page address
+ *  commands set the window, and data fills it in horizontal addressing
+ *  order. Tests read back the pixels and count the data bytes that reached
+ *  the display RAM.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class MockOled {
+ public:
+  static const uint8_t WIDTH = 128;
+  static const uint8_t PAGES = 8;
+
+  MockOled() { reset(); }
+
+  void reset();
+
+  // A transmission to the panel starts; the next byte is a control byte
+  void startTransmission();
+  void write(uint8_t value);
+
+  // Display RAM byte (bit 0 = top pixel of the page), and single pixels
+  uint8_t ram(uint8_t page, uint8_t x) const { return gddram[page & 7][x & 0x7F]; }
+  bool pixel(uint8_t x, uint8_t y) const { return ram(y / 8, x) & (1 << (y % 8)); }
+  bool displayOn() const { return on; }
+
+  // Traffic since reset() or clearCounters()
+  uint32_t busBytes() const { return busBytesCount; }
+  uint32_t dataBytes() const { return dataBytesCount; }
+  void clearCounters() { busBytesCount = dataBytesCount = 0; }
+
+ private:
+  void command(uint8_t value);
+  void data(uint8_t value);
+
+  uint8_t gddram[PAGES][WIDTH];
+  uint8_t colStart, colEnd, pageStart, pageEnd;
+  uint8_t col, page;
+  bool on;
+
+  bool expectControl;
+  bool dataMode;
+  bool singleByte;  // Co set: one byte, then another control byte
+  uint8_t command0;
+  uint8_t paramsWanted;
+  uint8_t params[2];
+  uint8_t paramCount;
+
+  uint32_t busBytesCount;
+  uint32_t dataBytesCount;
+};
+
+extern MockOled mockOled;
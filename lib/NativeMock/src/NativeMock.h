@@ -0,0 +1,49 @@
+/*
+ *  GearPulse - controls for the native mock backend
+ *  --------------------------------------
+ *  Tests drive the firmware through these: queue bytes on the serial port,
+ *  advance simulated time (which also fires Tickers), press the touch pad,
+ *  and read back what was printed, what the LCD shows, how many heap
+ *  allocations happened and how often the EEPROM sector was written.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Serial input. Bytes that don't fit the RX buffer are dropped and flag an
+// overrun, as on the UART; returns the number accepted.
+size_t mockSerialFeed(const uint8_t* data, size_t length);
+size_t mockSerialFeed(const char* text);
+size_t mockSerialPending();
+
+// Everything the firmware printed since the last take, NUL-terminated. The log
+// holds MOCK_SERIAL_LOG bytes; later output is counted but not kept.
+const size_t MOCK_SERIAL_LOG = 4096;
+const char* mockSerialOutput();
+void mockSerialTake(char* out, size_t size);
+void mockSerialClear();
+
+// Simulated clock. mockAdvance() runs due Ticker callbacks along the way.
+void mockAdvance(unsigned long ms);
+void mockAdvanceMicros(unsigned long us);
+
+// Run the firmware's loop() once per simulated millisecond for `ms`
+void mockRun(unsigned long ms);
+
+// Level returned by digitalRead() for a pin. An attached interrupt handler
+// runs right away if the change matches its mode.
+void mockSetPin(uint8_t pin, int level);
+
+// Forced light sleeps entered, and the GPIO wake-up pins armed for the last
+// one (bit n = GPIOn)
+uint32_t mockLightSleeps();
+uint32_t mockWakeupPins();
+
+// EEPROM sector: erase to blank (0xFF), and commits since start
+void mockEepromErase();
+uint32_t mockEepromCommits();
+
+// operator new calls since start, for allocation-per-frame checks
+uint32_t mockAllocations();
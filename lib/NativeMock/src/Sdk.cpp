@@ -0,0 +1,66 @@
+#include "ESP8266WiFi.h"
+#include "NativeMock.h"
+
+extern "C" {
+#include "user_interface.h"
+#include "gpio.h"
+}
+
+ESP8266WiFiClass WiFi;
+
+static uint32_t lightSleeps = 0;
+static uint32_t wakeupPins = 0;
+static uint32_t sleepPins = 0;
+static bool fpmOpen = false;
+static enum sleep_type fpmType = NONE_SLEEP_T;
+
+uint32_t mockLightSleeps() {
+  return lightSleeps;
+}
+
+uint32_t mockWakeupPins() {
+  return sleepPins;
+}
+
+extern "C" {
+
+void wifi_fpm_set_sleep_type(enum sleep_type type) {
+  fpmType = type;
+}
+
+void wifi_fpm_open(void) {
+  fpmOpen = true;
+}
+
+void wifi_fpm_close(void) {
+  fpmOpen = false;
+}
+
+int8_t wifi_fpm_do_sleep(uint32_t sleepTimeUs) {
+  (void)sleepTimeUs;
+  if (!fpmOpen) {
+    return -1;
+  }
+  if (fpmType == LIGHT_SLEEP_T) {
+    lightSleeps++;
+    sleepPins = wakeupPins;
+  }
+  return 0;
+}
+
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb) {
+  (void)cb;
+}
+
+void gpio_pin_wakeup_enable(uint32_t pin, GPIO_INT_TYPE level) {
+  (void)level;
+  if (pin < 32) {
+    wakeupPins |= 1u << pin;
+  }
+}
+
+void gpio_pin_wakeup_disable(void) {
+  wakeupPins = 0;
+}
+
+}
@@ -0,0 +1,48 @@
+#include "Ticker.h"
+#include "Arduino.h"
+
+static Ticker* armedTickers = nullptr;
+
+void Ticker::start(uint32_t ms, bool repeatCallback, callback_function_t fn) {
+  detach();
+  callback = fn;
+  interval = ms ? ms : 1;
+  due = millis() + interval;
+  repeat = repeatCallback;
+  armed = true;
+  next = armedTickers;
+  armedTickers = this;
+}
+
+void Ticker::detach() {
+  if (!armed) {
+    return;
+  }
+  for (Ticker** link = &armedTickers; *link; link = &(*link)->next) {
+    if (*link == this) {
+      *link = next;
+      break;
+    }
+  }
+  armed = false;
+  next = nullptr;
+}
+
+void Ticker::runDue(unsigned long now) {
+  Ticker* ticker = armedTickers;
+  while (ticker) {
+    Ticker* following = ticker->next;  // the callback may detach this ticker
+    if (static_cast<long>(now - ticker->due) >= 0) {
+      if (ticker->repeat) {
+        ticker->due += ticker->interval;
+        ticker->callback();
+      } else {
+        // A one-shot callback may re-arm its ticker, so run a copy
+        callback_function_t fn = ticker->callback;
+        ticker->detach();
+        fn();
+      }
+    }
+    ticker = following;
+  }
+}
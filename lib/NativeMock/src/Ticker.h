@@ -0,0 +1,39 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 Ticker library
+ *  --------------------------------------
+ *  Callbacks run on the simulated clock from mockAdvance()/delay(), so
+ *  they fire between loop() passes rather than from a timer interrupt.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+class Ticker {
+ public:
+  typedef std::function<void(void)> callback_function_t;
+
+  Ticker() {}
+  ~Ticker() { detach(); }
+
+  void attach(float seconds, callback_function_t callback) { start(seconds * 1000, true, callback); }
+  void attach_ms(uint32_t ms, callback_function_t callback) { start(ms, true, callback); }
+  void once(float seconds, callback_function_t callback) { start(seconds * 1000, false, callback); }
+  void once_ms(uint32_t ms, callback_function_t callback) { start(ms, false, callback); }
+  void detach();
+  bool active() const { return armed; }
+
+  // Called by the mock clock on every simulated millisecond
+  static void runDue(unsigned long now);
+
+ private:
+  void start(uint32_t ms, bool repeat, callback_function_t callback);
+
+  callback_function_t callback;
+  uint32_t interval = 0;
+  unsigned long due = 0;
+  bool repeat = false;
+  bool armed = false;
+  Ticker* next = nullptr;  // list of armed tickers
+};
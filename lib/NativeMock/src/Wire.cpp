@@ -0,0 +1,32 @@
+#include "Wire.h"
+#include "MockLcd.h"
+#include "MockOled.h"
+
+TwoWire Wire;
+
+static bool isOled(uint8_t address) {
+  return address == 0x3C || address == 0x3D;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  target = address;
+  if (isOled(address)) {
+    mockOled.startTransmission();
+  }
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (isOled(target)) {
+    mockOled.write(b);
+  } else {
+    mockLcd.expanderWrite(b);
+  }
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    write(buffer[i]);
+  }
+  return size;
+}
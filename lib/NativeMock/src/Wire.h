@@ -0,0 +1,38 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 Wire library
+ *  --------------------------------------
+ *  Bytes sent to 0x3C/0x3D go to the SSD1306 model in MockOled, everything
+ *  else to the HD44780 model in MockLcd; every address acknowledges.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 128
+
+class TwoWire : public Stream {
+ public:
+  void begin() {}
+  void begin(int sda, int scl) { (void)sda; (void)scl; }
+  void setClock(uint32_t frequency) { clock = frequency; }
+  uint32_t getClock() const { return clock; }
+
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool sendStop = true) { (void)sendStop; return 0; }
+  uint8_t requestFrom(uint8_t address, uint8_t quantity) { (void)address; (void)quantity; return 0; }
+
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+
+ private:
+  uint32_t clock = 100000;
+  uint8_t target = 0;
+};
+
+extern TwoWire Wire;
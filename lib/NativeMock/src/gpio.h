@@ -0,0 +1,22 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 SDK's gpio.h
+ *  --------------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define GPIO_ID_PIN(n) (n)
+
+typedef enum {
+  GPIO_PIN_INTR_DISABLE = 0,
+  GPIO_PIN_INTR_POSEDGE = 1,
+  GPIO_PIN_INTR_NEGEDGE = 2,
+  GPIO_PIN_INTR_ANYEDGE = 3,
+  GPIO_PIN_INTR_LOLEVEL = 4,
+  GPIO_PIN_INTR_HILEVEL = 5
+} GPIO_INT_TYPE;
+
+void gpio_pin_wakeup_enable(uint32_t pin, GPIO_INT_TYPE level);
+void gpio_pin_wakeup_disable(void);
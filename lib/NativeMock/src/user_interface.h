@@ -0,0 +1,20 @@
+/*
+ *  GearPulse - native stand-in for the ESP8266 SDK's user_interface.h
+ *  --------------------------------------
+ *  Forced light sleep returns at once and is only counted (see
+ *  mockLightSleeps()); wake-up pins are recorded.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum sleep_type { NONE_SLEEP_T = 0, LIGHT_SLEEP_T, MODEM_SLEEP_T };
+
+typedef void (*fpm_wakeup_cb)(void);
+
+void wifi_fpm_set_sleep_type(enum sleep_type type);
+void wifi_fpm_open(void);
+void wifi_fpm_close(void);
+int8_t wifi_fpm_do_sleep(uint32_t sleepTimeUs);
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb);
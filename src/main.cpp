@@ -12,42 +12,190 @@
  *  License: MIT
  */
 
- #include <LiquidCrystal_I2C.h>
- #include <ArduinoJson.h>
+ #include <LcdDisplay.h>
+ #include <Ssd1306Display.h>
  #include <Ticker.h>
+ #include <BinaryFrame.h>
+ #include <JsonStreamParser.h>
+ #include <LocalClock.h>
+ #include <MetricSchema.h>
+ #include <Settings.h>
+ #include <CharFrameBuffer.h>
+ #include <GlyphCache.h>
+ #include <HistoryRing.h>
+ #include <SystemData.h>
+ #include <TextFormat.h>
+ #include <TimingStats.h>
+ #include <WindowStats.h>
+ #include <EventQueue.h>
+ #include <TouchGesture.h>
+ #include <TripleBuffer.h>
+ #include <EEPROM.h>
+ 
+ #ifdef ESP32
+ #include <WiFi.h>
+ #else
+ #include <ESP8266WiFi.h>
+ extern "C" {
+ #include <user_interface.h>
+ #include <gpio.h>
+ }
+ #endif
+ 
+ #ifdef WIFI_SSID
+ #include <WiFiUdp.h>
+ #endif
  
  // Serial port settings
  const int SERIAL_BAUD_RATE = 115200;
  
- // LCD setup
- LiquidCrystal_I2C lcd(0x27, 16, 2);
+ // Baud negotiation: "baud N" from the host switches both ends to N on trial,
+ // and the rate is kept only once a probe frame arrives intact at it. Hosts
+ // that never ask stay at SERIAL_BAUD_RATE.
+ const unsigned long SERIAL_MAX_BAUD = 2000000;
+ const unsigned long BAUD_TRIAL_MS = 1500;    // time for the probe to arrive
+ const unsigned long LINK_WINDOW_MS = 3000;   // error rate is judged per window
+ const uint8_t LINK_ERROR_LIMIT = 3;
+ const uint16_t LINK_NOISE_BYTES = 512;       // this much without a good frame is noise
+ unsigned long serialBaud = SERIAL_BAUD_RATE;
+ unsigned long previousBaud = SERIAL_BAUD_RATE;
+ bool baudTrial = false;
+ unsigned long baudTrialSince = 0;
+ unsigned long linkWindowSince = 0;
+ 
+ // Link quality counts run since boot and are only written by ingest; each
+ // window compares them with where it started
+ struct LinkCounts {
+   uint32_t bytes;
+   uint32_t good;
+   uint32_t errors;
+ };
+ LinkCounts linkCounts = {};
+ LinkCounts linkWindowStart = {};
+ 
+ // Wi-Fi ingest is compiled in when credentials are given as build flags:
+ //   -D WIFI_SSID=\"name\" -D WIFI_PASSWORD=\"secret\" [-D UDP_PORT=4210]
+ #ifdef WIFI_SSID
+ #ifndef WIFI_PASSWORD
+ #define WIFI_PASSWORD ""
+ #endif
+ #ifndef UDP_PORT
+ #define UDP_PORT 4210
+ #endif
+ WiFiUDP udp;
+ bool radioOn = false;
+ bool radioIdle = false;  // auto light sleep between beacons while nothing arrives
+ #endif
+ 
+ // ESP32 builds split the work between the cores: ingestTask() reads the
+ // serial port and UDP and parses frames on core 0, while loop() renders and
+ // handles touch on core 1. Host data crosses over in one triple buffer per
+ // host and everything else as IngestEvents, so neither core ever waits for
+ // the other. The ESP8266 runs both halves from loop().
+ #ifdef ESP32
+ #define INGEST_TASK
+ const BaseType_t INGEST_CORE = 0;
+ const uint32_t INGEST_STACK = 4096;
+ const UBaseType_t INGEST_PRIORITY = 2;  // above loop(), below the Wi-Fi stack
+ #endif
+ 
+ // Display panel, picked with build flags (see platformio.ini):
+ //   default                                         16x2 HD44780 LCD, PCF8574 backpack at 0x27
+ //   -D DISPLAY_LCD_COLS=20 -D DISPLAY_LCD_ROWS=4    20x4 LCD on the same backpack
+ //   -D DISPLAY_SSD1306                              128x64 OLED at 0x3C, as 16x4 characters
+ // Pages draw into a character grid of the panel's size and reach it only
+ // through the DisplayBackend interface.
+ // The bus runs at the panel's rated clock: 400 kHz for the SSD1306, 100 kHz
+ // for the PCF8574. Many LCD backpacks manage 400 kHz too; opt in with
+ // -D DISPLAY_I2C_CLOCK=400000 once yours has been seen to keep up.
+ #ifndef DISPLAY_I2C_CLOCK
+ #ifdef DISPLAY_SSD1306
+ #define DISPLAY_I2C_CLOCK 400000
+ #else
+ #define DISPLAY_I2C_CLOCK 100000
+ #endif
+ #endif
+ #ifdef DISPLAY_SSD1306
+ const uint8_t OLED_ADDRESS = 0x3C;
+ const uint8_t DISPLAY_COLS = Ssd1306Display::COLS;
+ const uint8_t DISPLAY_ROWS = Ssd1306Display::ROWS;
+ Ssd1306Display panel(OLED_ADDRESS);
+ #else
+ #ifndef DISPLAY_LCD_COLS
+ #define DISPLAY_LCD_COLS 16
+ #endif
+ #ifndef DISPLAY_LCD_ROWS
+ #define DISPLAY_LCD_ROWS 2
+ #endif
+ const uint8_t LCD_ADDRESS = 0x27;
+ const uint8_t DISPLAY_COLS = DISPLAY_LCD_COLS;
+ const uint8_t DISPLAY_ROWS = DISPLAY_LCD_ROWS;
+ LcdDisplay panel(LCD_ADDRESS, DISPLAY_COLS, DISPLAY_ROWS);
+ #endif
+ DisplayBackend& display = panel;
+ 
+ // Pages are two rows, centred on taller panels
+ const uint8_t PAGE_TOP = (DISPLAY_ROWS - 2) / 2;
  
  // TTP223 Touch sensor
+ #ifdef ESP32
+ const int TOUCH_PIN = 14;  // GPIO14, the pin labelled D5 on a NodeMCU
+ #else
  const int TOUCH_PIN = D5;
+ #endif
  
- // Touch handling
- unsigned long touchStartTime = 0;
- const unsigned long LONG_PRESS_TIME = 2000;
- bool touchActive = false;
- bool lastTouchState = false;
+ // Touch handling: an edge interrupt timestamps every transition into a
+ // queue, and the gesture decoder turns them into events in loop(), so a
+ // press is timed correctly however long the other work takes
+ const uint16_t LONG_PRESS_TIME = 2000;
+ const uint16_t DOUBLE_TAP_TIME = 250;   // a tap waits this long for a second one
+ const uint16_t TOUCH_DEBOUNCE_TIME = 15;
+ struct TouchEdge {
+   uint32_t at;
+   bool pressed;
+ };
+ EventQueue<TouchEdge, 16> touchEdges;
+ volatile bool touchEdgesLost = false;
+ TouchGesture touchGesture(LONG_PRESS_TIME, DOUBLE_TAP_TIME, TOUCH_DEBOUNCE_TIME);
  bool isPowerOn = true;
  
+ // Power sequence, stepped from loop() so serial ingest never stalls
+ enum PowerState { POWER_OFF, POWER_SPLASH, POWER_STARTING, POWER_READY, POWER_ON, POWER_STOPPING };
+ PowerState powerState = POWER_OFF;
+ unsigned long powerStateSince = 0;
+ const unsigned long SPLASH_TIME = 600;
+ const unsigned long STARTING_TIME = 1000;
+ const unsigned long READY_TIME = 1000;
+ const unsigned long POWER_OFF_TIME = 1000;
+ 
+ // Low power: with nothing to do, loop() light-sleeps instead of polling.
+ // Powered off it waits for the touch pad; powered on with the link quiet it
+ // also wakes on serial RX. Light sleep stops the system timer, so millis()
+ // skips the time asleep, and the byte that wakes the UART is lost.
+ const uint8_t SERIAL_RX_PIN = 3;          // GPIO3, UART0 RX
+ const unsigned long LINK_IDLE_MS = 3000;  // quiet this long before sleeping while on
+ const unsigned long WAKE_GRACE_MS = 20;   // time after a wake for the rest of a frame to arrive
+ const bool POWER_ON_BY_SERIAL = false;    // data arriving while off turns the display on
+ unsigned long lastLinkActivity = 0;
+ unsigned long awakeSince = 0;
+ 
  // Display mode
- enum DisplayMode { CPU, MEMORY, NETWORK, DATE_TIME, TOTAL_MODES };
+ enum DisplayMode { CPU, MEMORY, NETWORK, DATE_TIME, HISTORY, STATS, SENSORS, CORES, TOTAL_MODES };
  DisplayMode currentMode = CPU;
  
- // System data structure
- struct SystemData {
-   float cpuLoad, cpuTemp;
-   float gpuLoad, gpuTemp;
-   float ramTotal, ramUsed, ramPercent;
-   float netUpload, netDownload;
-   struct {
-     int year, month, day;
-     int hour, minute, second;
-     char period[3];  // "AM" or "PM"
-   } datetime;
- } sysData;
+ // Preferences kept across reboots (layout in Settings.h), in the EEPROM
+ // emulation. Each commit erases a flash sector, so changes are written
+ // SETTINGS_COMMIT_MS after the last one: paging through the display costs
+ // one write, not one per tap.
+ const uint8_t ALL_PAGES = (1u << TOTAL_MODES) - 1;
+ const uint8_t MAX_RENDER_RATE_HZ = 25;
+ const unsigned long SETTINGS_COMMIT_MS = 10000;
+ const Settings DEFAULT_SETTINGS = { CPU, ALL_PAGES, 10, BACKLIGHT_ALWAYS, false, SERIAL_BAUD_RATE };
+ Settings settings = DEFAULT_SETTINGS;
+ Settings savedSettings = DEFAULT_SETTINGS;
+ bool settingsPending = false;
+ unsigned long settingsChangedAt = 0;
+ bool backlightOn = false;
  
  // Custom character definitions - moved to PROGMEM to save RAM
  const PROGMEM byte upArrow[8] = {
@@ -64,379 +212,2538 @@
    { 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110 },
    { 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111 }  // full
  };
+
+ // Glyph IDs managed by the glyph cache. The empty bar is drawn as a space,
+ // so it never needs a CGRAM slot.
+ enum GlyphId : uint8_t {
+   GLYPH_UP_ARROW,
+   GLYPH_DOWN_ARROW,
+   GLYPH_BAR_1,  // barChars[1] .. barChars[5]
+   GLYPH_BAR_5 = GLYPH_BAR_1 + 4,
+   GLYPH_VBAR_1,  // vertical bars with 1..7 of the 8 pixel rows lit
+   GLYPH_VBAR_7 = GLYPH_VBAR_1 + 6,
+   GLYPH_COUNT
+ };
+ 
+ // Glyphs each page needs resident before it is drawn
+ const uint8_t NETWORK_GLYPHS[] = { GLYPH_DOWN_ARROW, GLYPH_UP_ARROW };
+ const uint8_t MEMORY_GLYPHS[] = { GLYPH_BAR_1, GLYPH_BAR_1 + 1, GLYPH_BAR_1 + 2, GLYPH_BAR_1 + 3, GLYPH_BAR_5 };
+ const uint8_t HISTORY_GLYPHS[] = {
+   GLYPH_VBAR_1, GLYPH_VBAR_1 + 1, GLYPH_VBAR_1 + 2, GLYPH_VBAR_1 + 3,
+   GLYPH_VBAR_1 + 4, GLYPH_VBAR_1 + 5, GLYPH_VBAR_7
+ };
+ const uint8_t FULL_BLOCK = 0xFF;  // built into the HD44780 character ROM
+ 
+ void uploadGlyph(uint8_t slot, uint8_t glyph);
+ GlyphCache glyphCache(uploadGlyph);
+ 
+ // Metric history for the sparkline page. Each sample is the peak level seen
+ // during its interval, so short spikes between samples are kept. The ring
+ // holds exactly what the sparkline shows: one sample per column, less the
+ // blank one after the newest.
+ enum HistoryMetric : uint8_t { HISTORY_CPU_LOAD, HISTORY_GPU_LOAD, HISTORY_CPU_TEMP, HISTORY_NET_DOWN, HISTORY_METRICS };
+ const uint8_t HISTORY_CAPACITY = DISPLAY_COLS - 1;
+ const unsigned long HISTORY_SAMPLE_MS = 1000;
+ const unsigned long HISTORY_ROTATE_MS = 5000;  // HISTORY page cycles through the metrics
+ unsigned long lastHistorySample = 0;
+ uint8_t historyMetric = HISTORY_CPU_LOAD;
+ unsigned long historyMetricSince = 0;
+ 
+ // Pages with more than fits on the display step through views every few seconds
+ const unsigned long PAGE_ROTATE_MS = 3000;
+ uint8_t pageView = 0;
+ unsigned long pageViewSince = 0;
+ 
+ // Rolling min/max/average per metric over 1 and 15 minutes, updated from
+ // every parsed frame, for the STATS page. Its views are all metrics over
+ // 1 minute, then over 15 minutes.
+ enum StatMetric : uint8_t { STAT_CPU_LOAD, STAT_GPU_LOAD, STAT_CPU_TEMP, STAT_GPU_TEMP, STAT_NET_UP, STAT_NET_DOWN, STAT_METRICS };
+ const char* const STAT_LABELS[STAT_METRICS] = { "CPU load", "GPU load", "CPU temp", "GPU temp", "NET up", "NET down" };
+ const MetricId STAT_SOURCES[STAT_METRICS] = {
+   METRIC_CPU_LOAD, METRIC_GPU_LOAD, METRIC_CPU_TEMP, METRIC_GPU_TEMP, METRIC_NET_UPLOAD, METRIC_NET_DOWNLOAD
+ };
+ typedef WindowStats<60000UL, 6> ShortStats;       // 10 s buckets
+ typedef WindowStats<15 * 60000UL, 5> LongStats;   // 3 min buckets
+ 
+ // SENSORS page: the optional sensors, two rows per view, label on the left
+ // and the value in the unit MetricSchema.h gives it. Sensors a host has
+ // never reported are left out.
+ struct SensorRow {
+   const char* label;
+   MetricId metric;
+ };
+ const SensorRow SENSOR_ROWS[] = {
+   { "Disk read",  METRIC_DISK_READ },
+   { "Disk write", METRIC_DISK_WRITE },
+   { "VRAM used",  METRIC_VRAM_USED },
+   { "VRAM total", METRIC_VRAM_TOTAL },
+   { "Fan",        METRIC_FAN_RPM },
+ };
+ const uint8_t SENSOR_ROW_COUNT = sizeof(SENSOR_ROWS) / sizeof(SENSOR_ROWS[0]);
+ 
+ // CORES page: one vertical bar per core, a row of cores per view
+ const uint8_t CORES_PER_VIEW = DISPLAY_COLS;
+ 
+ // Fields each page is formatted from. A frame that changes none of the
+ // inputs of the page on screen leaves the display alone; page views,
+ // history samples and the local clock mark it dirty on their own.
+ const FieldMask PAGE_INPUTS[TOTAL_MODES] = {
+   FIELD_CPU_LOAD | FIELD_CPU_TEMP | FIELD_GPU_LOAD | FIELD_GPU_TEMP,                      // CPU
+   FIELD_RAM_TOTAL | FIELD_RAM_USED | FIELD_RAM_PERCENT,                                   // MEMORY
+   FIELD_NET_UPLOAD | FIELD_NET_DOWNLOAD,                                                  // NETWORK
+   FIELD_YEAR | FIELD_MONTH | FIELD_DAY | FIELD_HOUR | FIELD_MINUTE | FIELD_SECOND | FIELD_PERIOD,  // DATE_TIME
+   0,                                                                                      // HISTORY: see pageInputs()
+   0,                                                                                      // STATS: see pageInputs()
+   FIELD_DISK_READ | FIELD_DISK_WRITE | FIELD_VRAM_USED | FIELD_VRAM_TOTAL | FIELD_FAN_RPM,  // SENSORS
+   FIELD_CORES                                                                             // CORES
+ };
+ const MetricId HISTORY_SOURCES[HISTORY_METRICS] = { METRIC_CPU_LOAD, METRIC_GPU_LOAD, METRIC_CPU_TEMP, METRIC_NET_DOWNLOAD };
+ 
+ // One slot per monitored PC, indexed by the host ID in each frame. Frames
+ // without an ID belong to host 0, so a single PC works as before.
+ const uint8_t MAX_HOSTS = 4;
+ const unsigned long HOST_TIMEOUT_MS = 10000;  // hosts silent this long are skipped
+ const unsigned long HOST_ROTATE_MS = 10000;   // time on each host when several report
+ const unsigned long HOST_BANNER_MS = 1000;    // "Host N" replaces row 0 after a switch
+ struct HostSlot {
+   SystemData data;  // latest values, fixed-point (see SystemData.h)
+   HistoryRing<HISTORY_CAPACITY> history[HISTORY_METRICS];
+   uint8_t historyPeak[HISTORY_METRICS];
+   ShortStats shortStats[STAT_METRICS];
+   LongStats longStats[STAT_METRICS];
+   FieldMask reported;  // every field any frame has carried
+   FieldMask changed;   // fields the last frame changed, or first reported
+   unsigned long lastFrame;
+   bool seen;
+ };
+ HostSlot hosts[MAX_HOSTS];
+ uint8_t currentHost = 0;
+ unsigned long hostShownSince = 0;
+ bool hostBanner = false;
+ 
+ // Wall clock shared by every host. Once a host has synced it, DATE_TIME is
+ // drawn from it and redrawn each second, whatever the hosts send.
+ LocalClock localClock;
+ int64_t clockSecondShown = -1;
+ 
+ // Line buffers are sized for the longest formatter output, not the display width
+ const uint8_t LINE_BUFFER_SIZE = 32;
+ 
+ // Outcome of feeding one byte to a frame parser
+ enum IngestResult : uint8_t { INGEST_PENDING, INGEST_DONE, INGEST_FAILED };
+ 
+ // UART receive buffer. The core's default 256 bytes fill in 2.8 ms at
+ // 921600 baud, less than one redraw over I2C.
+ const uint16_t SERIAL_RX_BUFFER = 2048;
+ 
+ // Bytes handled per ingest pass, so a burst can't starve touch and rendering
+ const uint16_t SERIAL_BYTES_PER_PASS = 512;
+ 
+ // Bytes taken from the UART buffer at once
+ const uint8_t SERIAL_CHUNK = 128;
+ uint8_t serialChunk[SERIAL_CHUNK];
+ 
+ // Binary frame decoder, runs alongside the JSON parser
+ BinaryFrameDecoder binaryDecoder;
+ 
+ // JSON updates are parsed as they stream in. Values are staged per input
+ // and applied together once the object is complete.
+ struct JsonStage {
+   SystemData data;
+   FieldMask fields;  // metrics the object carried
+   bool delta;
+   int32_t host;
+   ClockSync clock;
+   bool hasClock;  // the object carried clock.epoch
+   FrameTag tag;
+   bool tagged;    // the object carried seq
+ };
+ void onJsonValue(const JsonStreamParser& parser, void* context);
+ JsonStage serialStage;
+ JsonStreamParser serialJson(onJsonValue, &serialStage);
+ 
+ // Host commands share the link: short lines of lowercase words and numbers.
+ // Other text between frames (e.g. the tail of a frame cut off at boot) is
+ // dropped at the next line end.
+ const uint8_t COMMAND_BUFFER_SIZE = 32;
+ char commandBuffer[COMMAND_BUFFER_SIZE];
+ uint8_t commandLength = 0;
+ bool commandValid = true;
+ bool lineStart = true;
+ 
+ #ifdef WIFI_SSID
+ // Each UDP datagram carries one JSON object or one or more binary frames
+ BinaryFrameDecoder udpDecoder;
+ JsonStage udpStage;
+ JsonStreamParser udpJson(onJsonValue, &udpStage);
+ #endif
+ 
+ // What ingest hands to the rest of the firmware, apart from host data
+ enum IngestEventKind : uint8_t {
+   EVENT_FRAME,      // a tagged frame was stored (two cores only)
+   EVENT_CLOCK,
+   EVENT_PROBE,      // an intact baud probe arrived
+   EVENT_COMMAND,
+   EVENT_MESSAGE,    // a log line; `backoff` also asks the host to slow down
+   EVENT_UDP_STATS,  // "stats" datagram from address:port (two cores only)
+ };
+ struct IngestEvent {
+   IngestEventKind kind;
+   uint8_t host;
+   bool backoff;
+   FrameTag tag;
+   uint32_t rxUs;
+   uint32_t doneUs;
+   ClockSync clock;
+   const __FlashStringHelper* message;
+   uint32_t address;
+   uint16_t port;
+   char command[COMMAND_BUFFER_SIZE];
+ };
+ 
+ #ifdef INGEST_TASK
+ // Events wait here for loop(). The host's credit window keeps it short over
+ // serial; a flood of UDP frames can fill it, and then events are dropped.
+ EventQueue<IngestEvent, 16> ingestEvents;
+ 
+ // Host data as ingest last stored it, the base for the next delta, and its
+ // newest copy on the way to loop()
+ struct HostFrame {
+   SystemData data;
+   FieldMask reported;
+ };
+ HostFrame ingestHosts[MAX_HOSTS];
+ TripleBuffer<HostFrame> hostFrames[MAX_HOSTS];
+ bool hostShown[MAX_HOSTS];  // the data last taken over reached the screen
+ 
+ // State the ingest task owns but loop() needs changed, done before its next pass
+ enum IngestRequest : uint32_t {
+   REQUEST_RESET_SERIAL = 0x01,  // drop half-received frames after a baud switch
+   REQUEST_RESET_HOSTS = 0x02,
+   REQUEST_RESET_TIMING = 0x04,
+   REQUEST_OPEN_UDP = 0x08,
+   REQUEST_CLOSE_UDP = 0x10,
+ };
+ uint32_t ingestRequests = 0;
+ uint32_t creditsPending = 0;  // frames consumed by ingest, returned by loop()
+ volatile bool uartOverrun = false;  // set by the UART driver's event task
+ #ifdef WIFI_SSID
+ bool udpOpen = false;
+ WiFiUDP statsReply;  // loop() can't share the ingest task's socket
+ #endif
+ #endif
  
- // Serial buffer
- const size_t SERIAL_BUFFER_SIZE = 1024;
- char serialBuffer[SERIAL_BUFFER_SIZE];
- size_t serialBufferIndex = 0;
+ // Render scheduling: ingest only marks the display dirty, and the render tick
+ // draws the latest state at most once per interval (settings.renderRateHz)
+ Ticker renderTicker;
+ volatile bool renderDue = true;
+ bool displayDirty = false;
  
- // Display tracking buffer to reduce flicker
- char previousDisplayLines[2][17]; // 16 chars + null terminator for each line
+ // Shadow framebuffer to reduce flicker: only changed cells reach the panel
+ CharFrameBuffer<DISPLAY_COLS, DISPLAY_ROWS> frameBuffer;
+ 
+ // Performance counters for the "stats" command. Counts run since boot;
+ // timings (in us) and the I2C rate cover the time since the last dump.
+ struct PerfCounters {
+   uint32_t framesReceived;
+   uint32_t framesParsed;
+   uint32_t framesRejected;
+   uint32_t bytesDropped;  // text thrown away between or after bad frames
+   uint32_t overruns;      // times the UART receive buffer overflowed
+   uint32_t framesUnseen;  // applied frames that changed nothing on the page shown
+ };
+ PerfCounters perf;
+ TimingStats parseTime;   // ingest time per completed frame
+ TimingStats renderTime;
+ TimingStats loopPeriod;
+ uint32_t parsePendingUs = 0;  // ingest time not yet attributed to a frame
+ uint32_t lastLoopStart = 0;
+ unsigned long statsSince = 0;
+ uint32_t statsI2cBytes = 0;
+ 
+ // Back-channel on the serial link. Device records are lines starting with
+ // '@' so hosts can tell them from log output; host commands are text lines
+ // that don't start with '{'.
+ const uint8_t PROTOCOL_VERSION = 4;  // 2: clock sync, 3: metrics frames, 4: latency echo
+ const uint8_t CREDIT_WINDOW = 4;  // frames a host may send ahead of our @credit
+ const unsigned long CLOCK_INTERVAL_MS = 1000;  // DATE_TIME from the host changes once a second
+ const unsigned long MAX_INTERVAL_MS = 4000;
+ const int RX_HIGH_WATER = SERIAL_RX_BUFFER * 3 / 4;  // bytes queued in the UART buffer
+ const int RX_LOW_WATER = SERIAL_RX_BUFFER / 8;
+ const unsigned long BACKOFF_HOLD_MS = 2000;  // minimum time between rate steps
+ uint8_t rateBackoff = 0;  // requested interval is doubled this many times
+ unsigned long rateBackoffSince = 0;
+ long announcedInterval = -1;
+ 
+ // Latency echo: tagged frames (see FrameTag) are answered with
+ //   @lat seq=N sent=T rx=R done=D drawn=W
+ // R, D and W are micros() when the frame's first byte was read, when it was
+ // applied and when it reached the panel; drawn= is left out for frames that
+ // changed nothing on screen. Frames waiting for the render tick are held
+ // here and answered once drawn.
+ struct LatencyEcho {
+   FrameTag tag;
+   uint32_t rxUs;
+   uint32_t doneUs;
+ };
+ const uint8_t LATENCY_QUEUE = 4;
+ LatencyEcho latencyQueue[LATENCY_QUEUE];
+ uint8_t latencyQueued = 0;
+ uint32_t serialFrameStart = 0;  // first byte of the frame being read
  
  // Function prototypes
  void showMessage(const __FlashStringHelper* line1, const __FlashStringHelper* line2 = nullptr);
  void showMessage(const __FlashStringHelper* line1, const String& line2);
- void updateDisplayLine(uint8_t line, const char* newContent);
+ void flushDisplay();
+ void requirePageGlyphs(DisplayMode mode);
  void powerOn();
  void powerOff();
+ void setPowerState(PowerState state);
+ void updatePowerSequence();
+ bool onFrameParsed(uint8_t host);
+ void noteLatency(const FrameTag& tag, uint32_t rxUs, uint32_t doneUs, bool shown);
+ void sendLatency(const LatencyEcho& echo, bool drawn, uint32_t drawnUs);
+ void echoDrawnFrames();
+ void renderIfDue();
+ void resetHosts();
+ bool hostActive(uint8_t host);
+ uint8_t nextActiveHost(uint8_t from);
+ void showHost(uint8_t host);
+ void updateHosts();
  void changeDisplayMode();
  void updateDisplay();
  void drawProgressBar(uint8_t percent);
- String formatNetSpeed(float bytesPerSec);
- bool parseJsonData(const char* jsonString);
+ uint8_t historyLevel(const SystemData& data, uint8_t metric);
+ void trackHistoryPeaks(HostSlot& slot);
+ void updateHistory();
+ int32_t statValue(const SystemData& data, uint8_t metric);
+ void trackStats(HostSlot& slot);
+ uint8_t formatStat(char* out, uint8_t metric, int32_t value);
+ uint8_t formatMetric(char* out, const SystemData& data, uint8_t metric);
+ uint8_t reportedSensors(const HostSlot& slot, uint8_t* rows);
+ uint8_t pageViews(DisplayMode mode);
+ FieldMask pageInputs(DisplayMode mode);
+ void updatePageView();
+ void drawCoreBars(const SystemData& data, uint8_t first);
+ void drawSparkline(const HistoryRing<HISTORY_CAPACITY>& ring);
+ void alignRight(char* line, uint8_t used, const char* text, uint8_t length);
+ void resetStage(JsonStage& stage);
+ bool commitJson(JsonStage& stage, uint8_t& host);
+ const SystemData& latestHostData(uint8_t host);
+ void storeHostData(uint8_t host, const SystemData& data, FieldMask fields);
+ void applyHostData(uint8_t host, const SystemData& data, FieldMask fields);
+ IngestResult processJsonByte(JsonStreamParser& parser, JsonStage& stage, char c, uint32_t startedUs);
+ bool applyBinaryFrame(const BinaryFrameDecoder& frame, uint8_t& host);
+ IngestResult processBinaryByte(BinaryFrameDecoder& decoder, uint8_t b, uint32_t startedUs);
  void processSerialData();
+ uint8_t processSerialChunk(const uint8_t* chunk, size_t length);
+ void returnCredit(uint8_t frames);
+ bool serialOverrun();
+ void resetSerialIngest();
+ IngestEvent makeEvent(IngestEventKind kind);
+ void postIngest(const IngestEvent& event);
+ void postMessage(const __FlashStringHelper* message, bool backoff = false);
+ void handleIngest(const IngestEvent& event);
+ void frameStored(uint8_t host, const FrameTag* tag, uint32_t rxUs);
+ #ifdef INGEST_TASK
+ void ingestTask(void*);
+ void requestIngest(uint32_t request);
+ void serveIngestRequests();
+ void drainIngest();
+ #endif
+ const uint8_t* findLineEnd(const uint8_t* data, size_t length);
+ void appendCommandChar(char c);
+ void finishCommand();
+ void handleCommand(const char* command);
+ void sendHello();
+ void sendStats(Print& out);
+ void noteIngestTime(uint32_t elapsed, uint8_t frames);
+ unsigned long desiredInterval();
+ void checkRxPressure();
+ void raiseBackoff();
+ void announceRate();
+ void requestBaud(unsigned long rate);
+ void switchBaud(unsigned long rate, const __FlashStringHelper* reason);
+ void confirmBaud();
+ void noteLinkResult(IngestResult result);
+ void updateBaud();
+ void IRAM_ATTR onTouchEdge();
+ void beginTouch();
+ void syncTouch();
+ void processTouch();
+ void handleGesture(Gesture gesture);
+ void beginWifi();
+ void endWifi();
+ void setRadioIdle(bool idle);
+ void processUdpData();
+ #ifdef WIFI_SSID
+ bool udpReady();
+ #endif
+ bool canSleep();
+ void idle();
+ #ifndef ESP32
+ void lightSleep(bool wakeOnSerial);
+ #endif
+ void applyClock(const ClockSync& sync);
+ void updateClock();
+ unsigned long preferredInterval();
+ bool validSettings(const Settings& candidate);
+ void loadSettings();
+ void changeSettings();
+ void saveSettings();
+ void updateSettings();
+ bool applySetting(const char* assignment);
+ void sendSettings();
+ void startRenderTicker();
+ DisplayMode nextPage(DisplayMode from);
+ void setBacklight(bool on);
+ void updateBacklight();
  
  void setup() {
-   Serial.begin(SERIAL_BAUD_RATE);
+   loadSettings();
+   serialBaud = settings.baud;
+   Serial.setRxBufferSize(SERIAL_RX_BUFFER);
+   Serial.begin(serialBaud);
+ #ifdef ESP32
+   Serial.onReceiveError([](hardwareSerial_error_t error) {
+     if (error == UART_FIFO_OVF_ERROR || error == UART_BUFFER_FULL_ERROR) {
+       uartOverrun = true;
+     }
+   });
+ #endif
    Serial.println(F("\nGearPulse - ESP Powered PC Hardware Monitor"));
  
    // Initialize random seed with a floating pin reading
    randomSeed(analogRead(A0));
  
-   pinMode(TOUCH_PIN, INPUT);
-   lcd.init();
-   
-   // Load custom characters from PROGMEM
-   byte tempChar[8];
-   memcpy_P(tempChar, upArrow, 8);
-   lcd.createChar(0, tempChar);
-   memcpy_P(tempChar, downArrow, 8);
-   lcd.createChar(1, tempChar);
+   beginTouch();
+   display.begin(DISPLAY_I2C_CLOCK);
    
-   for (uint8_t i = 0; i < 6; i++) {
-     memcpy_P(tempChar, barChars[i], 8);
-     lcd.createChar(i + 2, tempChar);
-   }
+   // Custom characters are uploaded on demand by the glyph cache
+   glyphCache.reset();
    
-   // Initialize display tracking buffer
-   memset(previousDisplayLines, 0, sizeof(previousDisplayLines));
+   // The panel starts blank; make the first flush write every cell
+   frameBuffer.invalidate();
    
+   // Brings the radio up, or turns it off in serial-only builds
    powerOn();
+   sendHello();
    
    // Setup the initial timing
+   startRenderTicker();
+   
+ #ifdef INGEST_TASK
+   xTaskCreatePinnedToCore(ingestTask, "ingest", INGEST_STACK, nullptr, INGEST_PRIORITY, nullptr, INGEST_CORE);
+ #endif
  }
  
  void loop() {
-   // Process touch and data when powered on
+   uint32_t loopStart = micros();
+   if (lastLoopStart) {
+     loopPeriod.add(loopStart - lastLoopStart);
+   }
+   lastLoopStart = loopStart;
+   
+   processTouch();
+   
+   // Process data when powered on
    if (isPowerOn) {
+     checkRxPressure();
+ #ifdef INGEST_TASK
+     drainIngest();  // parsed on the other core by ingestTask()
+ #else
      processSerialData();
+     processUdpData();
+ #endif
+   } else if (POWER_ON_BY_SERIAL && powerState == POWER_OFF && Serial.available()) {
+     powerOn();
+   }
+   
+   updatePowerSequence();
+   updateHosts();
+   updateHistory();
+   updatePageView();
+   updateClock();
+   updateBacklight();
+   renderIfDue();
+   announceRate();
+   updateBaud();
+   updateSettings();
+   
+   idle();
+ }
+ 
+ // Runs on every touch pin transition; the queue is read in loop()
+ void IRAM_ATTR onTouchEdge() {
+   TouchEdge edge = { static_cast<uint32_t>(millis()), digitalRead(TOUCH_PIN) == HIGH };
+   if (!touchEdges.push(edge)) {
+     touchEdgesLost = true;
    }
+ }
  
-   // Handle touch sensor
-   bool currentTouchState = digitalRead(TOUCH_PIN);
+ void beginTouch() {
+   pinMode(TOUCH_PIN, INPUT);
+   touchGesture.reset(digitalRead(TOUCH_PIN) == HIGH, millis());
+   attachInterrupt(digitalPinToInterrupt(TOUCH_PIN), onTouchEdge, CHANGE);
+ }
  
-   // Touch state machine with debouncing
-   if (currentTouchState && !lastTouchState) {
-     touchStartTime = millis();
-     touchActive = true;
+ // Catch up with the pin after edges were lost (queue overflow, light sleep)
+ void syncTouch() {
+   bool pressed = digitalRead(TOUCH_PIN) == HIGH;
+   if (pressed != touchGesture.pressed()) {
+     handleGesture(touchGesture.edge(pressed, millis()));
    }
+ }
  
-   if (!currentTouchState && lastTouchState && touchActive) {
-     unsigned long duration = millis() - touchStartTime;
-     if (duration >= LONG_PRESS_TIME) {
-       isPowerOn ? powerOff() : powerOn();
-     } else if (isPowerOn) {
-       changeDisplayMode();
-     }
-     touchActive = false;
+ void processTouch() {
+   // With one host a double-tap is just two taps, so don't wait to see one
+   touchGesture.setDoubleTap(nextActiveHost(currentHost) != currentHost);
+   TouchEdge edge;
+   while (touchEdges.pop(edge)) {
+     handleGesture(touchGesture.edge(edge.pressed, edge.at));
    }
+   if (touchEdgesLost) {
+     touchEdgesLost = false;
+     syncTouch();
+   }
+   handleGesture(touchGesture.poll(millis()));
+ }
  
-   lastTouchState = currentTouchState;
+ // Tap: next page. Double-tap: next host, or two pages on with only one host.
+ // Long press: power, reported while the pad is still held.
+ void handleGesture(Gesture gesture) {
+   if (gesture == GESTURE_LONG_PRESS) {
+     isPowerOn ? powerOff() : powerOn();
+     return;
+   }
+   if (!isPowerOn || gesture == GESTURE_NONE) {
+     return;
+   }
    
-   delay(10);
+   if (gesture == GESTURE_DOUBLE_TAP) {
+     uint8_t host = nextActiveHost(currentHost);
+     if (host != currentHost) {
+       showHost(host);
+       return;
+     }
+     changeDisplayMode();
+   }
+   changeDisplayMode();
  }
  
- // Process data from serial port
+ // Process data from serial port, a chunk at a time straight out of the
+ // UART buffer
  void processSerialData() {
-   while (Serial.available()) {
-     char c = Serial.read();
-     
-     // Add character to buffer if there's space
-     if (serialBufferIndex < SERIAL_BUFFER_SIZE - 1) {
-       serialBuffer[serialBufferIndex++] = c;
+   uint8_t consumed = 0;  // frames to hand back to the host as credit
+   uint32_t started = micros();
+   
+   if (serialOverrun()) {
+     perf.overruns++;
+   }
+   
+   uint16_t budget = SERIAL_BYTES_PER_PASS;
+   int pending = Serial.available();
+   if (pending > 0) {
+     lastLinkActivity = millis();
+   }
+   
+   while (budget > 0 && pending > 0) {
+     size_t wanted = min(static_cast<size_t>(min(pending, static_cast<int>(budget))), sizeof(serialChunk));
+     size_t length = Serial.readBytes(serialChunk, wanted);
+     if (length == 0) {
+       break;
      }
-     
-     // If end of JSON detected, process it
-     if (c == '\n' || c == '\r') {
-       // Null terminate the string
-       serialBuffer[serialBufferIndex] = '\0';
-       
-       // Only try to parse if there's actual content
-       if (serialBufferIndex > 2) {  // Minimum valid JSON is "{}"
-         if (parseJsonData(serialBuffer)) {
-           updateDisplay();
-         }
+     budget -= length;
+     linkCounts.bytes += length;
+     consumed += processSerialChunk(serialChunk, length);
+     pending = Serial.available();
+   }
+   
+   noteIngestTime(micros() - started, consumed);
+   returnCredit(consumed);
+ }
+ 
+ // One credit record per pass keeps the back-channel small. With two cores
+ // only loop() writes to the port, so it returns them on its next pass.
+ void returnCredit(uint8_t frames) {
+   if (!frames) {
+     return;
+   }
+ #ifdef INGEST_TASK
+   __atomic_fetch_add(&creditsPending, frames, __ATOMIC_RELAXED);
+ #else
+   Serial.print(F("@credit "));
+   Serial.println(frames);
+ #endif
+ }
+ 
+ bool serialOverrun() {
+ #ifdef ESP32
+   bool overrun = uartOverrun;
+   uartOverrun = false;
+   return overrun;
+ #else
+   return Serial.hasOverrun();
+ #endif
+ }
+ 
+ IngestEvent makeEvent(IngestEventKind kind) {
+   IngestEvent event;
+   memset(&event, 0, sizeof(event));
+   event.kind = kind;
+   return event;
+ }
+ 
+ // Hand an ingest outcome over: straight to handleIngest() on one core,
+ // queued for loop() on two
+ void postIngest(const IngestEvent& event) {
+ #ifdef INGEST_TASK
+   ingestEvents.push(event);
+ #else
+   handleIngest(event);
+ #endif
+ }
+ 
+ void postMessage(const __FlashStringHelper* message, bool backoff) {
+   IngestEvent event = makeEvent(EVENT_MESSAGE);
+   event.message = message;
+   event.backoff = backoff;
+   postIngest(event);
+ }
+ 
+ // The rest of the firmware's side of ingest, always run from loop()
+ void handleIngest(const IngestEvent& event) {
+   switch (event.kind) {
+     case EVENT_CLOCK:
+       applyClock(event.clock);
+       break;
+     case EVENT_PROBE:
+       confirmBaud();
+       break;
+     case EVENT_COMMAND:
+       handleCommand(event.command);
+       break;
+     case EVENT_MESSAGE:
+       Serial.println(event.message);
+       if (event.backoff) {
+         raiseBackoff();
        }
-       
-       // Reset buffer for next JSON
-       serialBufferIndex = 0;
+       break;
+ #ifdef INGEST_TASK
+     case EVENT_FRAME:
+       noteLatency(event.tag, event.rxUs, event.doneUs, hostShown[event.host]);
+       break;
+ #ifdef WIFI_SSID
+     case EVENT_UDP_STATS:
+       statsReply.beginPacket(IPAddress(event.address), event.port);
+       sendStats(statsReply);
+       statsReply.endPacket();
+       break;
+ #endif
+ #endif
+     default:
+       break;
+   }
+ }
+ 
+ // A frame's data has been stored. On one core it is shown right away; on
+ // two, loop() takes the data from hostFrames and a tag follows as an event.
+ void frameStored(uint8_t host, const FrameTag* tag, uint32_t rxUs) {
+ #ifdef INGEST_TASK
+   if (tag) {
+     IngestEvent event = makeEvent(EVENT_FRAME);
+     event.host = host;
+     event.tag = *tag;
+     event.rxUs = rxUs;
+     event.doneUs = micros();
+     postIngest(event);
+   }
+ #else
+   bool shown = onFrameParsed(host);
+   if (tag) {
+     noteLatency(*tag, rxUs, micros(), shown);
+   }
+ #endif
+ }
+ 
+ #ifdef INGEST_TASK
+ // Core 0: read and parse whatever has arrived, once per tick
+ void ingestTask(void*) {
+   for (;;) {
+     serveIngestRequests();
+     if (isPowerOn) {
+       processSerialData();
+       processUdpData();
      }
+     // A pass per tick outruns 2 Mbaud, and the idle task gets its turn
+     vTaskDelay(1);
    }
  }
  
- // Update a single line of the display only if its content has changed
- void updateDisplayLine(uint8_t line, const char* newContent) {
-   // Check if the new content is different from what's currently displayed
-   if (strcmp(newContent, previousDisplayLines[line]) != 0) {
-     // Content is different, update the display
-     lcd.setCursor(0, line);
-     
-     // First clear the line with spaces
-     lcd.print("                "); // 16 spaces
-     
-     // Then write the new content
-     lcd.setCursor(0, line);
-     lcd.print(newContent);
-     
-     // Save the new content
-     strcpy(previousDisplayLines[line], newContent);
+ void requestIngest(uint32_t request) {
+   __atomic_fetch_or(&ingestRequests, request, __ATOMIC_RELEASE);
+ }
+ 
+ void serveIngestRequests() {
+   uint32_t requests = __atomic_exchange_n(&ingestRequests, 0, __ATOMIC_ACQUIRE);
+   if (requests & REQUEST_RESET_SERIAL) {
+     resetSerialIngest();
+   }
+   if (requests & REQUEST_RESET_HOSTS) {
+     for (uint8_t i = 0; i < MAX_HOSTS; i++) {
+       memset(&ingestHosts[i], 0, sizeof(HostFrame));
+       strcpy(ingestHosts[i].data.datetime.period, "??");
+     }
+   }
+   if (requests & REQUEST_RESET_TIMING) {
+     parseTime.reset();
    }
+ #ifdef WIFI_SSID
+   if ((requests & REQUEST_CLOSE_UDP) && udpOpen) {
+     udp.stop();
+     udpOpen = false;
+   }
+   if ((requests & REQUEST_OPEN_UDP) && !udpOpen) {
+     udpOpen = udp.begin(UDP_PORT);
+   }
+ #endif
  }
  
- void showMessage(const __FlashStringHelper* line1, const __FlashStringHelper* line2) {
-   lcd.clear();
-   lcd.setCursor(0, 0); lcd.print(line1);
-   if (line2) {
-     lcd.setCursor(0, 1); 
-     lcd.print(line2);
+ // Core 1: take over what the ingest task has parsed since the last pass,
+ // the newest data of each host first and then the events in order
+ void drainIngest() {
+   // Ingest publishes a frame's data before posting its event, so the data
+   // for every event up to here is taken over below before they are handled
+   uint8_t eventsEnd = ingestEvents.mark();
+   for (uint8_t host = 0; host < MAX_HOSTS; host++) {
+     if (hostFrames[host].consume()) {
+       const HostFrame& frame = hostFrames[host].front();
+       applyHostData(host, frame.data, frame.reported);
+       hostShown[host] = onFrameParsed(host);
+     }
    }
    
-   // Update the tracking buffer with the new content
-   strncpy(previousDisplayLines[0], (const char*)line1, 16);
-   previousDisplayLines[0][16] = '\0';
+   IngestEvent event;
+   while (ingestEvents.pop(event, eventsEnd)) {
+     handleIngest(event);
+   }
    
-   if (line2) {
-     strncpy(previousDisplayLines[1], (const char*)line2, 16);
-   } else {
-     strcpy(previousDisplayLines[1], "                ");
+   uint32_t credits = __atomic_exchange_n(&creditsPending, 0, __ATOMIC_RELAXED);
+   if (credits) {
+     Serial.print(F("@credit "));
+     Serial.println(credits);
    }
-   previousDisplayLines[1][16] = '\0';
  }
+ #endif
  
- void showMessage(const __FlashStringHelper* line1, const String& line2) {
-   lcd.clear();
-   lcd.setCursor(0, 0); lcd.print(line1);
-   lcd.setCursor(0, 1); lcd.print(line2);
-   
-   // Update the tracking buffer with the new content
-   strncpy(previousDisplayLines[0], (const char*)line1, 16);
-   previousDisplayLines[0][16] = '\0';
+ // First line end in a chunk, or null
+ const uint8_t* findLineEnd(const uint8_t* data, size_t length) {
+   const uint8_t* newline = static_cast<const uint8_t*>(memchr(data, '\n', length));
+   const uint8_t* ret = static_cast<const uint8_t*>(memchr(data, '\r', newline ? newline - data : length));
+   return ret ? ret : newline;
+ }
+ 
+ // Each byte goes to whichever frame is in progress; between frames the first
+ // byte decides what comes next. Returns the number of frames completed.
+ uint8_t processSerialChunk(const uint8_t* chunk, size_t length) {
+   uint8_t consumed = 0;
    
-   strncpy(previousDisplayLines[1], line2.c_str(), 16);
-   previousDisplayLines[1][16] = '\0';
+   for (size_t i = 0; i < length; i++) {
+     uint8_t b = chunk[i];
+     char c = static_cast<char>(b);
+     
+     if (binaryDecoder.active()) {
+       IngestResult result = processBinaryByte(binaryDecoder, b, serialFrameStart);
+       if (result != INGEST_PENDING) {
+         consumed++;
+         lineStart = true;
+         noteLinkResult(result);
+       }
+       continue;
+     }
+     
+     // The rest of a rejected line is dropped in one go, up to its end
+     if (serialJson.skipping()) {
+       const uint8_t* end = findLineEnd(chunk + i, length - i);
+       size_t skipped = end ? end - (chunk + i) : length - i;
+       perf.bytesDropped += skipped;
+       i += skipped;
+       if (i < length) {
+         processJsonByte(serialJson, serialStage, static_cast<char>(chunk[i]), serialFrameStart);
+         lineStart = true;
+       }
+       continue;
+     }
+     
+     if (serialJson.active()) {
+       IngestResult result = processJsonByte(serialJson, serialStage, c, serialFrameStart);
+       if (result != INGEST_PENDING) {
+         consumed++;
+         lineStart = true;
+         noteLinkResult(result);
+       }
+       continue;
+     }
+     
+     if (c == '\n' || c == '\r') {
+       finishCommand();
+       lineStart = true;
+       continue;
+     }
+     
+     // A sync byte never appears in text, so it begins a binary frame even
+     // in the middle of a line of garbage
+     if (b == FRAME_SYNC) {
+       commandLength = 0;
+       commandValid = true;
+       serialFrameStart = micros();
+       processBinaryByte(binaryDecoder, b, serialFrameStart);
+       continue;
+     }
+     
+     if (lineStart && (c == ' ' || c == '\t')) {
+       continue;
+     }
+     
+     // Only a brace at the start of a line opens an object, so resync after
+     // a cut-off frame waits for the next line
+     if (lineStart && c == '{') {
+       lineStart = false;
+       serialFrameStart = micros();
+       serialJson.push(c);
+       continue;
+     }
+     
+     lineStart = false;
+     appendCommandChar(c);
+   }
+   return consumed;
  }
  
- void powerOn() {
-   lcd.backlight();
-   showMessage(F("GearPulse"));
+ // Spread the time of an ingest pass over the frames it completed. Passes
+ // that end no frame carry their time over to the next one that does.
+ void noteIngestTime(uint32_t elapsed, uint8_t frames) {
+   parsePendingUs += elapsed;
+   if (frames == 0) {
+     return;
+   }
+   uint32_t perFrame = parsePendingUs / frames;
+   for (uint8_t i = 0; i < frames; i++) {
+     parseTime.add(perFrame);
+   }
+   parsePendingUs = 0;
+ }
  
-   delay(600);
+ void appendCommandChar(char c) {
+   bool allowed = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                  c == ' ' || c == '.' || c == '-' || c == '_' || c == '=';
+   if (!allowed || commandLength >= COMMAND_BUFFER_SIZE - 1) {
+     commandValid = false;
+     perf.bytesDropped++;
+     return;
+   }
+   commandBuffer[commandLength++] = c;
+ }
  
-   showMessage(F("System Monitor"), F("Starting..."));
+ // Run the line collected so far if it looked like a command
+ void finishCommand() {
+   if (commandLength > 0 && commandValid) {
+     IngestEvent event = makeEvent(EVENT_COMMAND);
+     memcpy(event.command, commandBuffer, commandLength);
+     postIngest(event);
+     noteLinkResult(INGEST_DONE);
+   } else if (commandLength > 0 || !commandValid) {
+     noteLinkResult(INGEST_FAILED);  // line noise, e.g. after a bad baud switch
+     perf.bytesDropped += commandLength;
+   }
+   commandLength = 0;
+   commandValid = true;
+ }
  
-   // Initialize system data to zero
-   memset(&sysData, 0, sizeof(sysData));
-   strcpy(sysData.datetime.period, "??");  // Initialize period
-   
-   // Clear previous display lines
-   memset(previousDisplayLines, 0, sizeof(previousDisplayLines));
-   strcpy(previousDisplayLines[0], "                ");
-   strcpy(previousDisplayLines[1], "                ");
-   
-   isPowerOn = true;
+ // Text commands from the host
+ void handleCommand(const char* command) {
+   if (strcmp_P(command, PSTR("hello")) == 0) {
+     sendHello();
+   } else if (strcmp_P(command, PSTR("stats")) == 0) {
+     sendStats(Serial);
+   } else if (strncmp_P(command, PSTR("baud "), 5) == 0) {
+     requestBaud(strtoul(command + 5, nullptr, 10));
+   } else if (strcmp_P(command, PSTR("settings")) == 0) {
+     sendSettings();
+   } else if (strncmp_P(command, PSTR("set "), 4) == 0) {
+     if (applySetting(command + 4)) {
+       sendSettings();
+     } else {
+       Serial.print(F("@error bad setting: "));
+       Serial.println(command + 4);
+     }
+   } else {
+     Serial.print(F("@error unknown command: "));
+     Serial.println(command);
+   }
+ }
  
-   delay(1000);
-   showMessage(F("System Ready"), F("Waiting for data"));
-   delay(1000);
-   updateDisplay();
+ // Announce what we accept and how often we want data
+ void sendHello() {
+   announcedInterval = desiredInterval();
+   Serial.print(F("@hello proto="));
+   Serial.print(PROTOCOL_VERSION);
+   Serial.print(F(" formats=json,bin hosts="));
+   Serial.print(MAX_HOSTS);
+   Serial.print(F(" line="));
+   Serial.print(JSON_MAX_OBJECT);
+   Serial.print(F(" window="));
+   Serial.print(CREDIT_WINDOW);
+   Serial.print(F(" baud="));
+   Serial.print(serialBaud);
+   Serial.print(F(" maxbaud="));
+   Serial.print(SERIAL_MAX_BAUD);
+   Serial.print(F(" interval="));
+   Serial.println(announcedInterval);
  }
  
- void powerOff() {
-   isPowerOn = false;
+ // One compact record with every counter, then start a new timing window
+ void sendStats(Print& out) {
+   unsigned long now = millis();
+   uint32_t i2cBytes = display.bytesWritten();
+   unsigned long elapsed = max(now - statsSince, 1UL);
    
-   // Clear system data
-   memset(&sysData, 0, sizeof(sysData));
-   currentMode = CPU;
- 
-   showMessage(F("Powering Off..."));
-   delay(1000);
-   lcd.noBacklight();
- 
-   Serial.println(F("System powered off"));
+   out.print(F("@stats up="));
+   out.print(now / 1000);
+   out.print(F(" rx="));
+   out.print(perf.framesReceived);
+   out.print(F(" ok="));
+   out.print(perf.framesParsed);
+   out.print(F(" bad="));
+   out.print(perf.framesRejected);
+   out.print(F(" drop="));
+   out.print(perf.bytesDropped);
+   out.print(F(" ovr="));
+   out.print(perf.overruns);
+   out.print(F(" same="));
+   out.print(perf.framesUnseen);
+   
+   const TimingStats* timings[] = { &parseTime, &renderTime, &loopPeriod };
+   const __FlashStringHelper* names[] = { F(" parse="), F(" render="), F(" loop=") };
+   for (uint8_t i = 0; i < 3; i++) {
+     out.print(names[i]);
+     out.print(timings[i]->min());
+     out.print('/');
+     out.print(timings[i]->average());
+     out.print('/');
+     out.print(timings[i]->max());
+   }
+   
+   out.print(F(" i2c="));
+   out.print(static_cast<uint32_t>((uint64_t)(i2cBytes - statsI2cBytes) * 1000 / elapsed));
+   uint32_t heap = ESP.getFreeHeap();
+ #ifdef ESP32
+   uint32_t block = ESP.getMaxAllocHeap();
+   uint8_t fragmentation = heap ? 100 - static_cast<uint64_t>(block) * 100 / heap : 0;
+ #else
+   uint32_t block = ESP.getMaxFreeBlockSize();
+   uint8_t fragmentation = ESP.getHeapFragmentation();
+ #endif
+   out.print(F(" heap="));
+   out.print(heap);
+   out.print(F(" frag="));
+   out.print(fragmentation);
+   out.print(F(" block="));
+   out.print(block);
+   out.print(F(" baud="));
+   out.println(serialBaud);
+   
+ #ifdef INGEST_TASK
+   requestIngest(REQUEST_RESET_TIMING);  // parse times are the ingest task's
+ #else
+   parseTime.reset();
+ #endif
+   renderTime.reset();
+   loopPeriod.reset();
+   statsSince = now;
+   statsI2cBytes = i2cBytes;
  }
  
- void changeDisplayMode() {
-   currentMode = static_cast<DisplayMode>((currentMode + 1) % TOTAL_MODES);
-   updateDisplay();
+ // Update interval the display can actually use; 0 asks the host to pause
+ unsigned long desiredInterval() {
+   if (!isPowerOn) {
+     return 0;
+   }
+   if (currentMode == DATE_TIME && localClock.valid()) {
+     return MAX_INTERVAL_MS;  // the clock runs locally; data only feeds the other pages
+   }
+   unsigned long base = currentMode == DATE_TIME ? CLOCK_INTERVAL_MS : preferredInterval();
+   return min(base << rateBackoff, MAX_INTERVAL_MS);
  }
  
- void updateDisplay() {
-   // Create buffers for the new display content
-   char newLine0[17] = {0}; // 16 characters + null terminator
-   char newLine1[17] = {0};
-   char netBuffer[17] = {0}; // Buffer for network data
-   int netPos;
-   
-   switch (currentMode) {
-     case CPU:  // Show CPU + GPU info
-       sprintf_P(newLine0, PSTR("CPU:  %d%cC %.1f%%"), 
-                static_cast<int>(round(sysData.cpuTemp)), 
-                223, // ° symbol
-                sysData.cpuLoad);
-                
-       sprintf_P(newLine1, PSTR("GPU:  %d%cC %.1f%%"), 
-                static_cast<int>(round(sysData.gpuTemp)), 
-                223, // ° symbol
-                sysData.gpuLoad);
-       break;
+ // Ask for a slower rate while the UART buffer is filling, and step back
+ // towards the preferred rate once it has stayed nearly empty
+ void checkRxPressure() {
+   int pending = Serial.available();
+   if (pending >= RX_HIGH_WATER) {
+     raiseBackoff();
+   } else if (pending <= RX_LOW_WATER && rateBackoff > 0 &&
+              millis() - rateBackoffSince >= BACKOFF_HOLD_MS) {
+     rateBackoff--;
+     rateBackoffSince = millis();
+   }
+ }
  
-     case MEMORY:
-       sprintf_P(newLine0, PSTR("RAM: %d/%dGB %d%%"), 
-                static_cast<int>(sysData.ramUsed),
-                static_cast<int>(sysData.ramTotal),
-                static_cast<int>(sysData.ramPercent));
-       
-       strcpy(newLine1, "                "); // 16 spaces
-       break;
+ void raiseBackoff() {
+   if (millis() - rateBackoffSince < BACKOFF_HOLD_MS || (preferredInterval() << rateBackoff) >= MAX_INTERVAL_MS) {
+     return;
+   }
+   rateBackoff++;
+   rateBackoffSince = millis();
+ }
  
-     case NETWORK:
-       strcpy(newLine0, "NET:");
-       
-       netBuffer[0] = 1; // down arrow character code
-       strcat(netBuffer, ":");
-       strcat(netBuffer, formatNetSpeed(sysData.netDownload).c_str());
-       strcat(netBuffer, " ");
-       netPos = strlen(netBuffer);
-       netBuffer[netPos] = 0; // up arrow character
-       netBuffer[netPos+1] = '\0';
-       strcat(netBuffer, ":");
-       strcat(netBuffer, formatNetSpeed(sysData.netUpload).c_str());
-       strcpy(newLine1, netBuffer);
-       break;
- 
-     case DATE_TIME:
-       // Format date: MM/DD/YYYY
-       sprintf_P(newLine0, PSTR("%02d/%02d/%04d"), 
-         sysData.datetime.month,
-         sysData.datetime.day,
-         sysData.datetime.year);
-       
-       // Format time: HH:MM:SS PM/AM
-       sprintf_P(newLine1, PSTR("%02d:%02d:%02d %s"),
-         sysData.datetime.hour,
-         sysData.datetime.minute,
-         sysData.datetime.second,
-         sysData.datetime.period);
-       break;
-       
-     default:
-       // Handle any other mode (including TOTAL_MODES)
-       strcpy(newLine0, "Unknown Mode");
-       strcpy(newLine1, "Press to change");
-       break;
+ // Tell the host whenever the interval we want changes
+ void announceRate() {
+   long interval = desiredInterval();
+   if (interval == announcedInterval) {
+     return;
    }
+   announcedInterval = interval;
+   Serial.print(F("@rate "));
+   Serial.println(interval);
+ }
  
-   updateDisplayLine(0, newLine0);
-   updateDisplayLine(1, newLine1);
+ // Start a trial at the requested rate. The reply goes out at the old rate;
+ // the host switches once it has read it and then sends a probe frame.
+ void requestBaud(unsigned long rate) {
+   if (rate < 9600 || rate > SERIAL_MAX_BAUD || baudTrial) {
+     Serial.print(F("@baud "));
+     Serial.print(rate);
+     Serial.println(F(" unsupported"));
+     return;
+   }
    
-   if (currentMode == MEMORY) {
-     lcd.setCursor(0, 1);
-     drawProgressBar(static_cast<uint8_t>(sysData.ramPercent));
-     char progressBuffer[17] = "                ";
-     strcpy(previousDisplayLines[1], progressBuffer);
+   Serial.print(F("@baud "));
+   Serial.print(rate);
+   Serial.println(F(" ok"));
+   previousBaud = serialBaud;
+   switchBaud(rate, nullptr);
+   baudTrial = true;
+   baudTrialSince = millis();
+ }
+ 
+ // Change our side of the link, first telling the host why if there's a reason
+ void switchBaud(unsigned long rate, const __FlashStringHelper* reason) {
+   if (reason) {
+     Serial.print(F("@baud "));
+     Serial.print(rate);
+     Serial.print(' ');
+     Serial.println(reason);
    }
+   Serial.flush();  // let the old rate finish sending
+   Serial.updateBaudRate(rate);
+   serialBaud = rate;
    
-   if (currentMode == NETWORK) {
-     lcd.setCursor(0, 1);
-     lcd.write(1); // down arrow
-     lcd.setCursor(strlen(newLine1) - formatNetSpeed(sysData.netUpload).length() - 2, 1);
-     lcd.write(0); // up arrow
+   // Half-received frames were sent at the other rate
+ #ifdef INGEST_TASK
+   requestIngest(REQUEST_RESET_SERIAL);
+ #else
+   resetSerialIngest();
+ #endif
+   
+   linkWindowSince = millis();
+   linkWindowStart = linkCounts;
+ }
+ 
+ void resetSerialIngest() {
+   binaryDecoder.reset();
+   serialJson.reset();
+   resetStage(serialStage);
+   commandLength = 0;
+   commandValid = true;
+   lineStart = true;
+ }
+ 
+ // An intact probe during a trial confirms the new rate; without one the
+ // trial times out and falls back
+ void confirmBaud() {
+   if (!baudTrial) {
+     return;
    }
+   baudTrial = false;
+   Serial.print(F("@baud "));
+   Serial.print(serialBaud);
+   Serial.println(F(" confirm"));
  }
  
- String formatNetSpeed(float bytesPerSec) {
-   char buffer[10];
-   
-   if (bytesPerSec < 1024.0) {
-     sprintf_P(buffer, PSTR("%.0fB"), bytesPerSec);
-   } else if (bytesPerSec < 1024.0 * 1024.0) {
-     sprintf_P(buffer, PSTR("%.0fK"), bytesPerSec / 1024.0);
-   } else {
-     sprintf_P(buffer, PSTR("%.1fM"), bytesPerSec / (1024.0 * 1024.0));
+ void noteLinkResult(IngestResult result) {
+   if (result == INGEST_DONE) {
+     linkCounts.good++;
+   } else if (result == INGEST_FAILED) {
+     linkCounts.errors++;
    }
-   
-   return String(buffer);
  }
  
- void drawProgressBar(uint8_t percent) {
-   constexpr uint8_t totalBlocks = 16;  // LCD width
-   uint8_t fullChars = (percent * totalBlocks * 5) / 100 / 5;
-   uint8_t remainder = ((percent * totalBlocks * 5) / 100) % 5;
+ // End failed trials, and fall back from a negotiated rate whose error rate
+ // stays high: a window with traffic but mostly errors, or nothing usable
+ void updateBaud() {
+   unsigned long now = millis();
    
-   // Build the progress bar in our tracking buffer first
-   char progressBar[17];
-   
-   for (uint8_t i = 0; i < totalBlocks; i++) {
-     if (i < fullChars) {
-       progressBar[i] = 7;  // full block character code
-     } else if (i == fullChars && remainder > 0) {
-       progressBar[i] = 2 + remainder; // partial block character code
-     } else {
-       progressBar[i] = 2; // empty block character code
+   if (baudTrial) {
+     if (now - baudTrialSince >= BAUD_TRIAL_MS) {
+       baudTrial = false;
+       switchBaud(previousBaud, nullptr);
+       Serial.print(F("@baud "));
+       Serial.print(serialBaud);
+       Serial.println(F(" revert"));
      }
+     return;
    }
-   progressBar[16] = '\0';
    
-   // Compare with previous state
-   if (strcmp(progressBar, previousDisplayLines[1]) != 0) {
-     // Only update if different
-     lcd.setCursor(0, 1);
-     
-     for (uint8_t i = 0; i < totalBlocks; i++) {
-       lcd.write(progressBar[i]);
-     }
-     
-     // Update the tracking buffer
-     strcpy(previousDisplayLines[1], progressBar);
+   if (now - linkWindowSince < LINK_WINDOW_MS) {
+     return;
    }
+   LinkCounts counts = linkCounts;
+   uint32_t good = counts.good - linkWindowStart.good;
+   uint32_t errors = counts.errors - linkWindowStart.errors;
+   bool failing = (errors >= LINK_ERROR_LIMIT && errors >= good) ||
+                  (good == 0 && counts.bytes - linkWindowStart.bytes >= LINK_NOISE_BYTES);
+   if (failing && serialBaud != SERIAL_BAUD_RATE) {
+     unsigned long fallback = previousBaud < serialBaud ? previousBaud : SERIAL_BAUD_RATE;
+     previousBaud = SERIAL_BAUD_RATE;
+     switchBaud(fallback, F("fallback"));
+     return;
+   }
+   linkWindowSince = now;
+   linkWindowStart = counts;
+ }
+ 
+ // Serial-only builds keep the radio off; the SDK would otherwise restore
+ // whatever mode an earlier firmware saved to flash
+ void beginWifi() {
+   WiFi.persistent(false);  // don't rewrite the credentials to flash every boot
+ #ifdef WIFI_SSID
+   if (radioOn) {
+     return;
+   }
+   WiFi.mode(WIFI_STA);
+ #ifdef ESP32
+   WiFi.setSleep(false);
+ #else
+   WiFi.setSleepMode(WIFI_MODEM_SLEEP);
+ #endif
+   WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+ #ifdef INGEST_TASK
+   requestIngest(REQUEST_OPEN_UDP);
+ #else
+   udp.begin(UDP_PORT);
+ #endif
+   radioOn = true;
+   radioIdle = false;
+ #else
+   WiFi.mode(WIFI_OFF);
+ #endif
  }
  
- bool parseJsonData(const char* jsonString) {
-   // Use JsonDocument instead of StaticJsonDocument (updated for newer ArduinoJson versions)
-   JsonDocument doc;
-   DeserializationError error = deserializeJson(doc, jsonString);
+ // Radio off while powered off; forced light sleep needs it in NULL mode
+ void endWifi() {
+ #ifdef WIFI_SSID
+   if (!radioOn) {
+     return;
+   }
+ #ifdef INGEST_TASK
+   requestIngest(REQUEST_CLOSE_UDP);
+ #else
+   udp.stop();
+ #endif
+   WiFi.disconnect(true);
+   WiFi.mode(WIFI_OFF);
+   radioOn = false;
+ #endif
+ }
+ 
+ // Wi-Fi builds can't stop the radio while on, but between datagrams the SDK
+ // may light-sleep from beacon to beacon; the AP holds packets meanwhile
+ void setRadioIdle(bool idle) {
+ #ifdef WIFI_SSID
+   if (!radioOn || idle == radioIdle) {
+     return;
+   }
+   // The ESP32 has no light sleep between beacons; modem sleep is the idle mode
+ #ifdef ESP32
+   WiFi.setSleep(idle);
+ #else
+   WiFi.setSleepMode(idle ? WIFI_LIGHT_SLEEP : WIFI_MODEM_SLEEP);
+ #endif
+   radioIdle = idle;
+ #else
+   (void)idle;
+ #endif
+ }
  
-   if (error) {
-     Serial.print(F("JSON parse error: "));
-     Serial.println(error.c_str());
+ // Nothing is in progress that a sleep (or the lost wake-up byte) would break
+ bool canSleep() {
+   if (touchGesture.busy() || digitalRead(TOUCH_PIN) || !touchEdges.empty() ||
+       millis() - awakeSince < WAKE_GRACE_MS) {
+     return false;
+   }
+   // The commit timer stops too; wait for it rather than write early
+   if (settingsPending) {
      return false;
    }
+   if (!isPowerOn) {
+     return powerState == POWER_OFF;
+   }
+   // The local clock needs its page redrawn every second
+   bool clockShown = currentMode == DATE_TIME && localClock.valid();
+   return powerState == POWER_ON && !displayDirty && !hostBanner && !baudTrial && !clockShown &&
+          millis() - lastLinkActivity >= LINK_IDLE_MS;
+ }
  
-   // Use temporary variables to ensure atomic updates
-   SystemData tempData;
-   
-   // Parse existing data
-   tempData.cpuLoad = doc["cpu"]["load"].as<float>();
-   tempData.cpuTemp = doc["cpu"]["temp"].as<float>();
-   tempData.gpuLoad = doc["gpu"]["load"].as<float>();
-   tempData.gpuTemp = doc["gpu"]["temp"].as<float>();
-   tempData.ramTotal = doc["ram"]["total"].as<float>();
-   tempData.ramUsed = doc["ram"]["used"].as<float>();
-   tempData.ramPercent = doc["ram"]["usagePercent"].as<float>();
-   tempData.netUpload = doc["network"]["upload"].as<float>();
-   tempData.netDownload = doc["network"]["download"].as<float>();
- 
-   // Parse date and time
-   tempData.datetime.year = doc["date"]["year"] | 0;
-   tempData.datetime.month = doc["date"]["month"] | 0;
-   tempData.datetime.day = doc["date"]["day"] | 0;
-   tempData.datetime.hour = doc["time"]["hour"] | 0;
-   tempData.datetime.minute = doc["time"]["minute"] | 0;
-   tempData.datetime.second = doc["time"]["second"] | 0;
-   strlcpy(tempData.datetime.period, doc["time"]["period"] | "??", sizeof(tempData.datetime.period));
+ // End of each loop() pass: sleep until the next event if possible. Touch
+ // no longer needs polling, so otherwise the next pass starts right away.
+ void idle() {
+   bool sleepy = canSleep();
+ #ifdef WIFI_SSID
+   if (radioOn) {
+     setRadioIdle(sleepy);
+     if (sleepy) {
+       delay(10);  // the SDK only light-sleeps inside delay()
+     } else {
+       yield();
+     }
+     return;
+   }
+ #endif
+ #ifdef ESP32
+   // Forced light sleep would stop the ingest core too
+   if (sleepy) {
+     delay(10);
+   } else {
+     yield();
+   }
+ #else
+   if (sleepy) {
+     lightSleep(isPowerOn || POWER_ON_BY_SERIAL);
+   } else {
+     yield();
+   }
+ #endif
+ }
+ 
+ #ifndef ESP32
+ // Forced light sleep until the touch pad (or the serial line) goes active.
+ // The SDK only wakes on levels, which is fine: the TTP223 holds its output
+ // high while touched and a start bit pulls RX low.
+ void lightSleep(bool wakeOnSerial) {
+   Serial.flush();  // the UART stops while asleep
+   
+   wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+   wifi_fpm_open();
+   gpio_pin_wakeup_enable(GPIO_ID_PIN(TOUCH_PIN), GPIO_PIN_INTR_HILEVEL);
+   if (wakeOnSerial) {
+     gpio_pin_wakeup_enable(GPIO_ID_PIN(SERIAL_RX_PIN), GPIO_PIN_INTR_LOLEVEL);
+   }
+   wifi_fpm_do_sleep(0xFFFFFFF);  // no timer: only a pin wakes us
+   delay(10);                     // the SDK enters sleep during this delay
+   
+   // Disabling the wake-up pins also clears their interrupt type
+   gpio_pin_wakeup_disable();
+   wifi_fpm_close();
+   awakeSince = millis();
+   attachInterrupt(digitalPinToInterrupt(TOUCH_PIN), onTouchEdge, CHANGE);
+   syncTouch();  // the press that woke us happened while the CPU was stopped
+   
+   // millis() stood still while asleep, so the local clock is behind by an
+   // unknown amount; ask the host for a new sync
+   if (localClock.valid()) {
+     localClock.reset();
+     Serial.println(F("@clock unsynced"));
+   }
+ }
+ #endif
+ 
+ // A clock sync from any host, over either link and format
+ void applyClock(const ClockSync& sync) {
+   localClock.sync(sync, millis());
+   clockSecondShown = -1;
+ }
+ 
+ // Mark DATE_TIME dirty whenever the local clock reaches a new second
+ void updateClock() {
+   if (powerState != POWER_ON || currentMode != DATE_TIME || !localClock.valid()) {
+     return;
+   }
+   int64_t second = localClock.localSeconds(millis());
+   if (second != clockSecondShown) {
+     clockSecondShown = second;
+     displayDirty = true;
+   }
+ }
+ 
+ // Render ticks are the fastest a page is redrawn, so faster data is wasted
+ unsigned long preferredInterval() {
+   return 1000 / settings.renderRateHz;
+ }
+ 
+ void startRenderTicker() {
+   renderTicker.attach_ms(preferredInterval(), []() { renderDue = true; });
+ }
+ 
+ bool validSettings(const Settings& candidate) {
+   return candidate.mode < TOTAL_MODES && candidate.pages && !(candidate.pages & ~ALL_PAGES) &&
+          candidate.renderRateHz >= 1 && candidate.renderRateHz <= MAX_RENDER_RATE_HZ &&
+          candidate.backlight <= BACKLIGHT_ACTIVE &&
+          candidate.baud >= 9600 && candidate.baud <= SERIAL_MAX_BAUD;
+ }
+ 
+ // A blank, corrupt or out-of-range image leaves the defaults in place
+ void loadSettings() {
+   EEPROM.begin(SETTINGS_SIZE);
+   uint8_t image[SETTINGS_SIZE];
+   for (uint8_t i = 0; i < SETTINGS_SIZE; i++) {
+     image[i] = EEPROM.read(i);
+   }
+   Settings stored;
+   settings = decodeSettings(image, stored) && validSettings(stored) ? stored : DEFAULT_SETTINGS;
+   savedSettings = settings;
+ }
+ 
+ // Something in `settings` changed; the commit waits for things to settle
+ void changeSettings() {
+   settingsPending = true;
+   settingsChangedAt = millis();
+ }
+ 
+ // Write pending changes now. Nothing is written if they cancelled out,
+ // e.g. paging all the way round back to the saved page.
+ void saveSettings() {
+   if (!settingsPending) {
+     return;
+   }
+   settingsPending = false;
+   if (sameSettings(settings, savedSettings)) {
+     return;
+   }
+   uint8_t image[SETTINGS_SIZE];
+   encodeSettings(settings, image);
+   for (uint8_t i = 0; i < SETTINGS_SIZE; i++) {
+     EEPROM.write(i, image[i]);
+   }
+   EEPROM.commit();
+   savedSettings = settings;
+ }
+ 
+ void updateSettings() {
+   if (settingsPending && millis() - settingsChangedAt >= SETTINGS_COMMIT_MS) {
+     saveSettings();
+   }
+ }
+ 
+ // "key=value" from a "set" command. Applies at once except baud, which is
+ // the rate the next boot starts at (negotiation still works from there).
+ bool applySetting(const char* assignment) {
+   const char* equals = strchr(assignment, '=');
+   if (!equals || equals == assignment || equals - assignment >= 12 || !equals[1]) {
+     return false;
+   }
+   char key[12];
+   memcpy(key, assignment, equals - assignment);
+   key[equals - assignment] = '\0';
+   char* end;
+   unsigned long value = strtoul(equals + 1, &end, 10);
+   if (*end) {
+     return false;
+   }
+   
+   Settings next = settings;
+   if (strcmp_P(key, PSTR("baud")) == 0) {
+     next.baud = value;
+   } else if (value > 0xFF) {
+     return false;
+   } else if (strcmp_P(key, PSTR("pages")) == 0) {
+     next.pages = value;
+   } else if (strcmp_P(key, PSTR("rate")) == 0) {
+     next.renderRateHz = value;
+   } else if (strcmp_P(key, PSTR("backlight")) == 0) {
+     next.backlight = value;
+   } else if (strcmp_P(key, PSTR("fastboot")) == 0 && value <= 1) {
+     next.fastBoot = value;
+   } else {
+     return false;
+   }
+   if (!validSettings(next)) {
+     return false;
+   }
+   
+   bool rateChanged = next.renderRateHz != settings.renderRateHz;
+   settings = next;
+   changeSettings();
+   if (rateChanged) {
+     startRenderTicker();
+   }
+   if (isPowerOn && !(settings.pages & (1u << currentMode))) {
+     changeDisplayMode();
+   }
+   return true;
+ }
+ 
+ void sendSettings() {
+   Serial.print(F("@settings mode="));
+   Serial.print(settings.mode);
+   Serial.print(F(" pages="));
+   Serial.print(settings.pages);
+   Serial.print(F(" rate="));
+   Serial.print(settings.renderRateHz);
+   Serial.print(F(" backlight="));
+   Serial.print(settings.backlight);
+   Serial.print(F(" fastboot="));
+   Serial.print(settings.fastBoot ? 1 : 0);
+   Serial.print(F(" baud="));
+   Serial.println(settings.baud);
+ }
+ 
+ // The next enabled page after `from`, or `from` if it is the only one
+ DisplayMode nextPage(DisplayMode from) {
+   for (uint8_t step = 1; step <= TOTAL_MODES; step++) {
+     DisplayMode mode = static_cast<DisplayMode>((from + step) % TOTAL_MODES);
+     if (settings.pages & (1u << mode)) {
+       return mode;
+     }
+   }
+   return from;
+ }
+ 
+ void setBacklight(bool on) {
+   backlightOn = on;
+   display.setBacklight(on);
+ }
+ 
+ // BACKLIGHT_ACTIVE: dark while no host is reporting, back on with the next frame
+ void updateBacklight() {
+   if (powerState != POWER_ON) {
+     return;
+   }
+   bool wanted = settings.backlight == BACKLIGHT_ALWAYS || hostActive(currentHost) ||
+                 hostActive(nextActiveHost(currentHost));
+   if (wanted != backlightOn) {
+     setBacklight(wanted);
+   }
+ }
+ 
+ #ifdef WIFI_SSID
+ // On two cores the socket belongs to the ingest task, which opens and closes
+ // it when asked
+ bool udpReady() {
+ #ifdef INGEST_TASK
+   return udpOpen;
+ #else
+   return radioOn;
+ #endif
+ }
+ #endif
+ 
+ // Feed every pending datagram through the same parsers as the serial path
+ void processUdpData() {
+ #ifdef WIFI_SSID
+   while (udpReady() && udp.parsePacket() > 0) {
+     lastLinkActivity = millis();
+ #ifndef INGEST_TASK
+     setRadioIdle(false);
+ #endif
+     
+     // Datagrams already have boundaries; a lost one is replaced by the next
+     udpDecoder.reset();
+     udpJson.reset();
+     resetStage(udpStage);
+     
+     uint32_t started = micros();
+     uint8_t frames = 0;
+     uint8_t chunk[128];
+     bool first = true;
+     bool binary = false;
+     int length;
+     while ((length = udp.read(chunk, sizeof(chunk))) > 0) {
+       if (first) {
+         // A datagram starting with a letter is a command; the reply goes
+         // back to the sender
+         if (chunk[0] >= 'a' && chunk[0] <= 'z') {
+           if (length >= 5 && memcmp_P(chunk, PSTR("stats"), 5) == 0) {
+ #ifdef INGEST_TASK
+             IngestEvent event = makeEvent(EVENT_UDP_STATS);
+             event.address = static_cast<uint32_t>(udp.remoteIP());
+             event.port = udp.remotePort();
+             postIngest(event);
+ #else
+             udp.beginPacket(udp.remoteIP(), udp.remotePort());
+             sendStats(udp);
+             udp.endPacket();
+ #endif
+           }
+           break;
+         }
+         binary = chunk[0] == FRAME_SYNC;
+         first = false;
+       }
+       for (int i = 0; i < length; i++) {
+         IngestResult result = binary ? processBinaryByte(udpDecoder, chunk[i], started)
+                                      : processJsonByte(udpJson, udpStage, static_cast<char>(chunk[i]), started);
+         if (result != INGEST_PENDING) {
+           frames++;
+         }
+       }
+     }
+     
+     // The end of the datagram ends the line, and with it any open object
+     if (!first && !binary && processJsonByte(udpJson, udpStage, '\n', started) != INGEST_PENDING) {
+       frames++;
+     }
+     noteIngestTime(micros() - started, frames);
+   }
+ #endif
+ }
+ 
+ // Feed one byte to a JSON parser and apply the object once it is complete.
+ // `startedUs` is when the object's first byte was read.
+ IngestResult processJsonByte(JsonStreamParser& parser, JsonStage& stage, char c, uint32_t startedUs) {
+   switch (parser.push(c)) {
+     case JsonStreamParser::OBJECT_DONE: {
+       uint8_t host;
+       perf.framesReceived++;
+       if (stage.hasClock) {
+         IngestEvent event = makeEvent(EVENT_CLOCK);
+         event.clock = stage.clock;
+         postIngest(event);
+       }
+       if (stage.hasClock && !stage.fields && !stage.delta) {
+         perf.framesParsed++;  // a sync on its own leaves the host data alone
+       } else if (commitJson(stage, host)) {
+         perf.framesParsed++;
+         frameStored(host, stage.tagged ? &stage.tag : nullptr, startedUs);
+       } else {
+         perf.framesRejected++;
+       }
+       resetStage(stage);
+       return INGEST_DONE;
+     }
+ 
+     case JsonStreamParser::PARSE_FAILED:
+       perf.framesReceived++;
+       perf.framesRejected++;
+       switch (parser.error()) {
+         case JSON_TOO_DEEP:   postMessage(F("JSON parse error: nested too deep")); break;
+         case JSON_TOO_LONG:   postMessage(F("JSON parse error: object too long"), true); break;
+         case JSON_BAD_KEY:    postMessage(F("JSON parse error: key too long")); break;
+         case JSON_INCOMPLETE: postMessage(F("JSON parse error: incomplete object")); break;
+         default:              postMessage(F("JSON parse error: invalid input")); break;
+       }
+       resetStage(stage);
+       return INGEST_FAILED;
+ 
+     default:
+       return INGEST_PENDING;
+   }
+ }
+ 
+ // Feed one byte to the binary frame decoder and apply the frame once it is complete
+ IngestResult processBinaryByte(BinaryFrameDecoder& decoder, uint8_t b, uint32_t startedUs) {
+   switch (decoder.push(b)) {
+     case BinaryFrameDecoder::FRAME_READY: {
+       perf.framesReceived++;
+       if (decoder.kind() == FRAME_PROBE) {
+         perf.framesParsed++;
+         if (checkProbePattern(decoder.payload(), decoder.payloadLength())) {
+           postIngest(makeEvent(EVENT_PROBE));
+         }
+         return INGEST_DONE;
+       }
+       if (decoder.kind() == FRAME_CLOCK) {
+         IngestEvent event = makeEvent(EVENT_CLOCK);
+         if (decodeClockV1(decoder.payload(), decoder.payloadLength(), event.clock)) {
+           perf.framesParsed++;
+           postIngest(event);
+         } else {
+           perf.framesRejected++;
+           postMessage(F("Binary frame error: bad clock"));
+         }
+         return INGEST_DONE;
+       }
+       uint8_t host;
+       if (applyBinaryFrame(decoder, host)) {
+         perf.framesParsed++;
+         FrameTag tag = decoder.tag();
+         frameStored(host, decoder.tagged() ? &tag : nullptr, startedUs);
+       } else {
+         perf.framesRejected++;
+       }
+       return INGEST_DONE;
+     }
+ 
+     case BinaryFrameDecoder::FRAME_FAILED:
+       perf.framesReceived++;
+       perf.framesRejected++;
+       switch (decoder.error()) {
+         case FRAME_BAD_LENGTH:  postMessage(F("Binary frame error: bad length")); break;
+         case FRAME_BAD_CRC:     postMessage(F("Binary frame error: bad CRC")); break;
+         case FRAME_BAD_VERSION: postMessage(F("Binary frame error: unsupported version")); break;
+         default:                postMessage(F("Binary frame error: unknown")); break;
+       }
+       return INGEST_FAILED;
+ 
+     default:
+       return INGEST_PENDING;
+   }
+ }
+ 
+ // Write the framebuffer cells that changed since the last flush
+ void flushDisplay() {
+   frameBuffer.flush(display);
+   display.present();
+ }
+ 
+ // Program a custom glyph slot with a bitmap from PROGMEM
+ void uploadGlyph(uint8_t slot, uint8_t glyph) {
+   byte tempChar[8];
+   if (glyph >= GLYPH_VBAR_1) {
+     // Vertical bars are generated: the bottom N rows are lit
+     uint8_t lit = glyph - GLYPH_VBAR_1 + 1;
+     for (uint8_t row = 0; row < 8; row++) {
+       tempChar[row] = (row >= 8 - lit) ? 0b11111 : 0b00000;
+     }
+   } else {
+     const byte* bitmap;
+     switch (glyph) {
+       case GLYPH_UP_ARROW:   bitmap = upArrow; break;
+       case GLYPH_DOWN_ARROW: bitmap = downArrow; break;
+       default:               bitmap = barChars[glyph - GLYPH_BAR_1 + 1]; break;
+     }
+     memcpy_P(tempChar, bitmap, 8);
+   }
+   display.defineGlyph(slot, tempChar);
+ }
+ 
+ // Load the glyphs a page uses; slots already holding them are left alone
+ void requirePageGlyphs(DisplayMode mode) {
+   switch (mode) {
+     case MEMORY:
+       glyphCache.require(MEMORY_GLYPHS, sizeof(MEMORY_GLYPHS));
+       break;
+     case NETWORK:
+       glyphCache.require(NETWORK_GLYPHS, sizeof(NETWORK_GLYPHS));
+       break;
+     case HISTORY:
+     case CORES:
+       glyphCache.require(HISTORY_GLYPHS, sizeof(HISTORY_GLYPHS));
+       break;
+     default:
+       break;
+   }
+ }
+ 
+ void showMessage(const __FlashStringHelper* line1, const __FlashStringHelper* line2) {
+   char buffer[DISPLAY_COLS + 1];
+   strncpy_P(buffer, reinterpret_cast<PGM_P>(line1), DISPLAY_COLS);
+   buffer[DISPLAY_COLS] = '\0';
+   frameBuffer.setLine(PAGE_TOP, buffer);
+   
+   if (line2) {
+     strncpy_P(buffer, reinterpret_cast<PGM_P>(line2), DISPLAY_COLS);
+     buffer[DISPLAY_COLS] = '\0';
+     frameBuffer.setLine(PAGE_TOP + 1, buffer);
+   } else {
+     frameBuffer.setLine(PAGE_TOP + 1, "");
+   }
+   
+   flushDisplay();
+ }
+ 
+ void showMessage(const __FlashStringHelper* line1, const String& line2) {
+   char buffer[DISPLAY_COLS + 1];
+   strncpy_P(buffer, reinterpret_cast<PGM_P>(line1), DISPLAY_COLS);
+   buffer[DISPLAY_COLS] = '\0';
+   frameBuffer.setLine(PAGE_TOP, buffer);
+   frameBuffer.setLine(PAGE_TOP + 1, line2.c_str());
+   
+   flushDisplay();
+ }
+ 
+ void powerOn() {
+   beginWifi();
+   setBacklight(true);
+   
+   // Fast boot skips the splash steps; either way the first frame ends the
+   // boot messages and shows the live page right away
+   if (settings.fastBoot) {
+     showMessage(F("GearPulse"), F("Waiting for data"));
+   } else {
+     showMessage(F("GearPulse"));
+   }
+ 
+   // Initialize system data to zero
+   resetHosts();
+   currentMode = (settings.pages & (1u << settings.mode)) ? static_cast<DisplayMode>(settings.mode)
+                                                            : nextPage(static_cast<DisplayMode>(settings.mode));
+   
+   // The panel may have been changed while off; redraw every cell
+   frameBuffer.invalidate();
+   
+   isPowerOn = true;
+   setPowerState(settings.fastBoot ? POWER_READY : POWER_SPLASH);
+ }
+ 
+ void powerOff() {
+   isPowerOn = false;
+   
+   // Clear system data
+   resetHosts();
+ 
+   showMessage(F("Powering Off..."));
+   setPowerState(POWER_STOPPING);
+ }
+ 
+ void setPowerState(PowerState state) {
+   powerState = state;
+   powerStateSince = millis();
+ }
+ 
+ // Advance the splash and power-off messages once their time is up
+ void updatePowerSequence() {
+   unsigned long elapsed = millis() - powerStateSince;
+ 
+   switch (powerState) {
+     case POWER_SPLASH:
+       if (elapsed >= SPLASH_TIME) {
+         showMessage(F("System Monitor"), F("Starting..."));
+         setPowerState(POWER_STARTING);
+       }
+       break;
+ 
+     case POWER_STARTING:
+       if (elapsed >= STARTING_TIME) {
+         showMessage(F("System Ready"), F("Waiting for data"));
+         setPowerState(POWER_READY);
+       }
+       break;
+ 
+     case POWER_READY:
+       if (elapsed >= READY_TIME) {
+         setPowerState(POWER_ON);
+         updateDisplay();
+       }
+       break;
+ 
+     case POWER_STOPPING:
+       if (elapsed >= POWER_OFF_TIME) {
+         setBacklight(false);
+         endWifi();
+         saveSettings();
+         setPowerState(POWER_OFF);
+         Serial.println(F("System powered off"));
+       }
+       break;
+ 
+     default:
+       break;
+   }
+ }
+ 
+ // A frame that arrives during the boot messages ends them and shows immediately;
+ // after that, frames only mark the display dirty for the render tick. Returns
+ // whether the frame reaches the screen: drawn now, or at the next render.
+ bool onFrameParsed(uint8_t host) {
+   HostSlot& slot = hosts[host];
+   bool wasActive = hostActive(host);
+   slot.seen = true;
+   slot.lastFrame = millis();
+   trackHistoryPeaks(slot);
+   trackStats(slot);
+   
+   // Follow the host that is talking if the one on screen has gone quiet
+   if (host != currentHost) {
+     if (hostActive(currentHost)) {
+       if (!wasActive) {
+         Serial.print(F("Host joined: "));
+         Serial.println(host);
+       }
+       return false;  // only the host on screen is ever formatted
+     }
+     showHost(host);
+   }
+   
+   if (powerState != POWER_ON) {
+     setPowerState(POWER_ON);
+     displayDirty = false;
+     updateDisplay();
+     return true;
+   }
+   
+   // Only the fields the page is drawn from are worth a redraw
+   if (slot.changed & pageInputs(currentMode)) {
+     displayDirty = true;
+   } else {
+     perf.framesUnseen++;
+   }
+   return displayDirty;
+ }
+ 
+ // Answer a tagged frame now if it is already on screen or never will be,
+ // otherwise once the render tick has drawn it
+ void noteLatency(const FrameTag& tag, uint32_t rxUs, uint32_t doneUs, bool shown) {
+   LatencyEcho echo = { tag, rxUs, doneUs };
+   if (!shown || !displayDirty) {
+     sendLatency(echo, shown, echo.doneUs);
+     return;
+   }
+   if (latencyQueued == LATENCY_QUEUE) {
+     // Faster than the render tick: the oldest is superseded, not drawn
+     sendLatency(latencyQueue[0], false, 0);
+     memmove(latencyQueue, latencyQueue + 1, sizeof(LatencyEcho) * (LATENCY_QUEUE - 1));
+     latencyQueued--;
+   }
+   latencyQueue[latencyQueued++] = echo;
+ }
+ 
+ void sendLatency(const LatencyEcho& echo, bool drawn, uint32_t drawnUs) {
+   Serial.print(F("@lat seq="));
+   Serial.print(echo.tag.seq);
+   Serial.print(F(" sent="));
+   Serial.print(echo.tag.sentUs);
+   Serial.print(F(" rx="));
+   Serial.print(echo.rxUs);
+   Serial.print(F(" done="));
+   Serial.print(echo.doneUs);
+   if (drawn) {
+     Serial.print(F(" drawn="));
+     Serial.print(drawnUs);
+   }
+   Serial.println();
+ }
+ 
+ // Called once a page has reached the panel
+ void echoDrawnFrames() {
+   uint32_t now = micros();
+   for (uint8_t i = 0; i < latencyQueued; i++) {
+     sendLatency(latencyQueue[i], true, now);
+   }
+   latencyQueued = 0;
+ }
+ 
+ // Draw the latest data if it changed and the render tick has fired since the
+ // last draw. Frames arriving in between just overwrite the host's data.
+ void renderIfDue() {
+   if (!displayDirty || !renderDue) {
+     return;
+   }
+   renderDue = false;
+   displayDirty = false;
+   updateDisplay();
+ }
+ 
+ // Clear every host slot, e.g. on power on/off
+ void resetHosts() {
+   for (uint8_t i = 0; i < MAX_HOSTS; i++) {
+     HostSlot& slot = hosts[i];
+     memset(&slot.data, 0, sizeof(slot.data));
+     strcpy(slot.data.datetime.period, "??");  // Initialize period
+     for (uint8_t metric = 0; metric < HISTORY_METRICS; metric++) {
+       slot.history[metric].clear();
+       slot.historyPeak[metric] = 0;
+     }
+     for (uint8_t metric = 0; metric < STAT_METRICS; metric++) {
+       slot.shortStats[metric].reset();
+       slot.longStats[metric].reset();
+     }
+     slot.reported = 0;
+     slot.changed = 0;
+     slot.seen = false;
+ #ifdef INGEST_TASK
+     hostShown[i] = false;
+ #endif
+   }
+   currentHost = 0;
+   hostBanner = false;
+ #ifdef INGEST_TASK
+   requestIngest(REQUEST_RESET_HOSTS);  // deltas must not patch the old data
+ #endif
+ }
+ 
+ bool hostActive(uint8_t host) {
+   return hosts[host].seen && millis() - hosts[host].lastFrame < HOST_TIMEOUT_MS;
+ }
+ 
+ // The next host after `from` that is still reporting, or `from` if none is
+ uint8_t nextActiveHost(uint8_t from) {
+   for (uint8_t step = 1; step < MAX_HOSTS; step++) {
+     uint8_t host = (from + step) % MAX_HOSTS;
+     if (hostActive(host)) {
+       return host;
+     }
+   }
+   return from;
+ }
+ 
+ // Put a host on screen, naming it on row 0 for a moment
+ void showHost(uint8_t host) {
+   hostShownSince = millis();
+   if (host == currentHost) {
+     return;
+   }
+   currentHost = host;
+   hostBanner = true;
+   displayDirty = true;
+ }
+ 
+ // Rotate through the reporting hosts and drop the banner once it has been seen
+ void updateHosts() {
+   unsigned long now = millis();
+   
+   if (hostBanner && now - hostShownSince >= HOST_BANNER_MS) {
+     hostBanner = false;
+     displayDirty = true;
+   }
+   
+   if (now - hostShownSince >= HOST_ROTATE_MS) {
+     showHost(nextActiveHost(currentHost));
+   }
+ }
+ 
+ // Short press steps through the pages; past the last one it moves on to the
+ // next host. Pressing also holds the current host against the rotation timer.
+ void changeDisplayMode() {
+   DisplayMode previous = currentMode;
+   currentMode = nextPage(currentMode);
+   settings.mode = currentMode;
+   changeSettings();
+   hostShownSince = millis();
+   if (currentMode <= previous) {  // wrapped past the last page
+     showHost(nextActiveHost(currentHost));
+   }
+   if (currentMode == HISTORY) {
+     historyMetric = HISTORY_CPU_LOAD;
+     historyMetricSince = millis();
+   }
+   pageView = 0;
+   pageViewSince = millis();
+   updateDisplay();
+ }
+ 
+ void updateDisplay() {
+   // Boot and power-off messages own the screen until they finish
+   if (powerState != POWER_ON) {
+     return;
+   }
+   uint32_t started = micros();
+   
+   // Create buffers for the new display content. They are larger than a
+   // line so formatters never overflow; setLine() clips to the display width.
+   char newLine0[LINE_BUFFER_SIZE] = {0};
+   char newLine1[LINE_BUFFER_SIZE] = {0};
+   char value[LINE_BUFFER_SIZE];
+   uint8_t pos;
+   uint8_t netPos = 0;
+   const SystemData& data = hosts[currentHost].data;
+   
+   requirePageGlyphs(currentMode);
+   
+   switch (currentMode) {
+     case CPU:  // Show CPU + GPU info
+       pos = formatText(newLine0, "CPU:  ");
+       pos += formatTemp10(newLine0 + pos, data.cpuTemp);
+       newLine0[pos++] = ' ';
+       formatPercent10(newLine0 + pos, data.cpuLoad);
+                
+       pos = formatText(newLine1, "GPU:  ");
+       pos += formatTemp10(newLine1 + pos, data.gpuTemp);
+       newLine1[pos++] = ' ';
+       formatPercent10(newLine1 + pos, data.gpuLoad);
+       break;
+ 
+     case MEMORY:
+       pos = formatText(newLine0, "RAM: ");
+       pos += formatUnsigned(newLine0 + pos, data.ramUsed / RAM_SCALE);
+       newLine0[pos++] = '/';
+       pos += formatUnsigned(newLine0 + pos, data.ramTotal / RAM_SCALE);
+       pos += formatText(newLine0 + pos, "GB ");
+       pos += formatUnsigned(newLine0 + pos, data.ramPercent / LOAD_SCALE);
+       formatText(newLine0 + pos, "%");
+       break;
+ 
+     case NETWORK:
+       formatText(newLine0, "NET:");
+       
+       // The spaces are placeholders for the arrow cells set below
+       pos = formatText(newLine1, " :");
+       pos += formatRate(newLine1 + pos, data.netDownload);
+       netPos = pos;
+       pos += formatText(newLine1 + pos, " :");
+       formatRate(newLine1 + pos, data.netUpload);
+       break;
+ 
+     case DATE_TIME: {
+       // The local clock once synced, otherwise the host's own fields
+       SystemData local;
+       const SystemData& clock = localClock.read(millis(), local) ? local : data;
+       
+       // Format date: MM/DD/YYYY
+       pos = formatPad2(newLine0, clock.datetime.month);
+       newLine0[pos++] = '/';
+       pos += formatPad2(newLine0 + pos, clock.datetime.day);
+       newLine0[pos++] = '/';
+       formatPad4(newLine0 + pos, clock.datetime.year);
+       
+       // Format time: HH:MM:SS PM/AM
+       pos = formatPad2(newLine1, clock.datetime.hour);
+       newLine1[pos++] = ':';
+       pos += formatPad2(newLine1 + pos, clock.datetime.minute);
+       newLine1[pos++] = ':';
+       pos += formatPad2(newLine1 + pos, clock.datetime.second);
+       newLine1[pos++] = ' ';
+       formatText(newLine1 + pos, clock.datetime.period);
+       break;
+     }
+       
+     case HISTORY:
+       // Label and current value on top, sparkline of the peaks below
+       switch (historyMetric) {
+         case HISTORY_CPU_LOAD:
+           pos = formatText(newLine0, "CPU load");
+           alignRight(newLine0, pos, value, formatPercent10(value, data.cpuLoad));
+           break;
+         case HISTORY_GPU_LOAD:
+           pos = formatText(newLine0, "GPU load");
+           alignRight(newLine0, pos, value, formatPercent10(value, data.gpuLoad));
+           break;
+         case HISTORY_CPU_TEMP:
+           pos = formatText(newLine0, "CPU temp");
+           alignRight(newLine0, pos, value, formatTemp10(value, data.cpuTemp));
+           break;
+         default:
+           pos = formatText(newLine0, "NET down");
+           alignRight(newLine0, pos, value, formatRate(value, data.netDownload));
+           break;
+       }
+       break;
+       
+     case STATS: {
+       // One metric over one window: min/average/max
+       uint8_t metric = pageView % STAT_METRICS;
+       bool longWindow = pageView % (2 * STAT_METRICS) >= STAT_METRICS;
+       const HostSlot& slot = hosts[currentHost];
+       int32_t low, high, average;
+       bool any;
+       if (longWindow) {
+         any = slot.longStats[metric].range(millis(), low, high);
+         average = slot.longStats[metric].average();
+       } else {
+         any = slot.shortStats[metric].range(millis(), low, high);
+         average = slot.shortStats[metric].average();
+       }
+       
+       pos = formatText(newLine0, STAT_LABELS[metric]);
+       alignRight(newLine0, pos, longWindow ? "15m" : "1m", longWindow ? 3 : 2);
+       
+       if (!any) {
+         formatText(newLine1, "no samples");
+         break;
+       }
+       pos = formatStat(newLine1, metric, low);
+       newLine1[pos++] = '/';
+       pos += formatStat(newLine1 + pos, metric, average);
+       newLine1[pos++] = '/';
+       formatStat(newLine1 + pos, metric, high);
+       break;
+     }
+       
+     case SENSORS: {
+       uint8_t rows[SENSOR_ROW_COUNT];
+       uint8_t count = reportedSensors(hosts[currentHost], rows);
+       if (count == 0) {
+         formatText(newLine0, "Sensors");
+         formatText(newLine1, "none reported");
+         break;
+       }
+       uint8_t first = pageView % ((count + 1) / 2) * 2;
+       for (uint8_t i = 0; i < 2 && first + i < count; i++) {
+         const SensorRow& row = SENSOR_ROWS[rows[first + i]];
+         char* line = i == 0 ? newLine0 : newLine1;
+         pos = formatText(line, row.label);
+         alignRight(line, pos, value, formatMetric(value, data, row.metric));
+       }
+       break;
+     }
+       
+     case CORES: {
+       // Average of the cores in view on top, one bar per core below
+       if (data.cores.count == 0) {
+         formatText(newLine0, "Cores");
+         formatText(newLine1, "none reported");
+         break;
+       }
+       uint8_t views = (data.cores.count + CORES_PER_VIEW - 1) / CORES_PER_VIEW;
+       uint8_t first = pageView % views * CORES_PER_VIEW;
+       uint8_t last = min<uint8_t>(first + CORES_PER_VIEW, data.cores.count);
+       uint16_t total = 0;
+       for (uint8_t core = first; core < last; core++) {
+         total += data.cores.load[core];
+       }
+       pos = formatText(newLine0, "Cores ");
+       pos += formatUnsigned(newLine0 + pos, first + 1);
+       newLine0[pos++] = '-';
+       pos += formatUnsigned(newLine0 + pos, last);
+       uint8_t length = formatUnsigned(value, (total / (last - first) + CORE_SCALE / 2) / CORE_SCALE);
+       length += formatText(value + length, "%");
+       alignRight(newLine0, pos, value, length);
+       break;
+     }
+       
+     default:
+       // Handle any other mode (including TOTAL_MODES)
+       formatText(newLine0, "Unknown Mode");
+       formatText(newLine1, "Press to change");
+       break;
+   }
+ 
+   // Name the host for a moment after switching to it
+   if (hostBanner) {
+     pos = formatText(newLine0, "Host ");
+     formatUnsigned(newLine0 + pos, currentHost);
+   }
+ 
+   frameBuffer.setLine(PAGE_TOP, newLine0);
+   frameBuffer.setLine(PAGE_TOP + 1, newLine1);
+   
+   if (currentMode == MEMORY) {
+     drawProgressBar(data.ramPercent / LOAD_SCALE);
+   }
+   
+   if (currentMode == HISTORY) {
+     drawSparkline(hosts[currentHost].history[historyMetric]);
+   }
+   
+   if (currentMode == CORES && data.cores.count) {
+     drawCoreBars(data, pageView % pageViews(CORES) * CORES_PER_VIEW);
+   }
+   
+   if (currentMode == NETWORK) {
+     frameBuffer.setCell(0, PAGE_TOP + 1, glyphCache.code(GLYPH_DOWN_ARROW));
+     frameBuffer.setCell(netPos, PAGE_TOP + 1, glyphCache.code(GLYPH_UP_ARROW));
+   }
+   
+   flushDisplay();
+   renderTime.add(micros() - started);
+   echoDrawnFrames();
+ }
+ 
+ // Finish a line with text ending in the last display column, spaces in between
+ void alignRight(char* line, uint8_t used, const char* text, uint8_t length) {
+   constexpr uint8_t width = DISPLAY_COLS;
+   uint8_t start = length < width ? width - length : 0;
+   while (used < start) {
+     line[used++] = ' ';
+   }
+   formatText(line + max(used, start), text);
+ }
+ 
+ void drawProgressBar(uint8_t percent) {
+   constexpr uint8_t totalBlocks = DISPLAY_COLS;
+   uint8_t fullChars = (percent * totalBlocks * 5) / 100 / 5;
+   uint8_t remainder = ((percent * totalBlocks * 5) / 100) % 5;
+   
+   // Draw the progress bar into the framebuffer; flushDisplay() sends the changes
+   for (uint8_t i = 0; i < totalBlocks; i++) {
+     if (i < fullChars) {
+       frameBuffer.setCell(i, PAGE_TOP + 1, glyphCache.code(GLYPH_BAR_5));  // full block
+     } else if (i == fullChars && remainder > 0) {
+       frameBuffer.setCell(i, PAGE_TOP + 1, glyphCache.code(GLYPH_BAR_1 + remainder - 1)); // partial block
+     } else {
+       frameBuffer.setCell(i, PAGE_TOP + 1, ' '); // empty block
+     }
+   }
+ }
+ 
+ // Quantize a metric to 0-255 for the history rings
+ uint8_t historyLevel(const SystemData& data, uint8_t metric) {
+   switch (metric) {
+     case HISTORY_CPU_LOAD: return min<uint16_t>(data.cpuLoad, 1000) * 255 / 1000;
+     case HISTORY_GPU_LOAD: return min<uint16_t>(data.gpuLoad, 1000) * 255 / 1000;
+     case HISTORY_CPU_TEMP: return constrain(data.cpuTemp, 0, 1275) / 5;  // 0.5 degC steps
+     default: {
+       // Network rates are logarithmic: 8 steps per doubling, 1 B/s .. 4 GB/s
+       uint32_t rate = data.netDownload;
+       if (rate == 0) {
+         return 0;
+       }
+       uint8_t msb = 31 - __builtin_clz(rate);
+       uint8_t fraction = msb >= 3 ? (rate >> (msb - 3)) & 0x07 : (rate << (3 - msb)) & 0x07;
+       return min(msb * 8 + fraction, 255);
+     }
+   }
+ }
+ 
+ void trackHistoryPeaks(HostSlot& slot) {
+   for (uint8_t metric = 0; metric < HISTORY_METRICS; metric++) {
+     slot.historyPeak[metric] = max(slot.historyPeak[metric], historyLevel(slot.data, metric));
+   }
+ }
+ 
+ // Push one peak sample per metric every HISTORY_SAMPLE_MS, for every host
+ // that is reporting so switching hosts shows a full sparkline
+ void updateHistory() {
+   unsigned long now = millis();
+   
+   if (currentMode == HISTORY && now - historyMetricSince >= HISTORY_ROTATE_MS) {
+     historyMetric = (historyMetric + 1) % HISTORY_METRICS;
+     historyMetricSince = now;
+     displayDirty = true;
+   }
+   
+   if (now - lastHistorySample < HISTORY_SAMPLE_MS) {
+     return;
+   }
+   lastHistorySample = now;
+   
+   for (uint8_t host = 0; host < MAX_HOSTS; host++) {
+     if (!hostActive(host)) {
+       continue;
+     }
+     HostSlot& slot = hosts[host];
+     for (uint8_t metric = 0; metric < HISTORY_METRICS; metric++) {
+       slot.history[metric].push(slot.historyPeak[metric]);
+       slot.historyPeak[metric] = historyLevel(slot.data, metric);  // next interval starts at the current value
+     }
+   }
+   
+   if (currentMode == HISTORY) {
+     displayDirty = true;
+   }
+ }
+ 
+ // Metric as the scaled integer SystemData stores it
+ int32_t statValue(const SystemData& data, uint8_t metric) {
+   return readMetric(data, STAT_SOURCES[metric]);
+ }
+ 
+ // One sample per metric and window from the frame just applied
+ void trackStats(HostSlot& slot) {
+   uint32_t now = millis();
+   for (uint8_t metric = 0; metric < STAT_METRICS; metric++) {
+     int32_t value = statValue(slot.data, metric);
+     slot.shortStats[metric].add(value, now);
+     slot.longStats[metric].add(value, now);
+   }
+ }
+ 
+ // Short forms so min/average/max fit one row: "12%", "45°C", "1.5M"
+ uint8_t formatStat(char* out, uint8_t metric, int32_t value) {
+   switch (metric) {
+     case STAT_CPU_LOAD:
+     case STAT_GPU_LOAD: {
+       uint8_t length = formatUnsigned(out, (max<int32_t>(value, 0) + LOAD_SCALE / 2) / LOAD_SCALE);
+       return length + formatText(out + length, "%");
+     }
+     case STAT_CPU_TEMP:
+     case STAT_GPU_TEMP:
+       return formatTemp10(out, constrain(value, INT16_MIN, INT16_MAX));
+     default:
+       return formatRate(out, max<int32_t>(value, 0));
+   }
+ }
+ 
+ // A metric in the unit the schema gives it: "1.5M", "3.2GB", "1200rpm"
+ uint8_t formatMetric(char* out, const SystemData& data, uint8_t metric) {
+   int32_t value = readMetric(data, metric);
+   uint8_t length;
+   switch (describeMetric(metric).unit) {
+     case UNIT_PERCENT10:
+       return formatPercent10(out, value);
+     case UNIT_CELSIUS10:
+       return formatTemp10(out, value);
+     case UNIT_GB100:
+       length = formatUnsigned(out, value / RAM_SCALE);
+       out[length++] = '.';
+       length += formatUnsigned(out + length, value % RAM_SCALE / 10);
+       return length + formatText(out + length, "GB");
+     case UNIT_RATE:
+       return formatRate(out, value);
+     case UNIT_RPM:
+       length = formatUnsigned(out, value);
+       return length + formatText(out + length, "rpm");
+     case UNIT_TEXT:
+       return formatText(out, reinterpret_cast<const char*>(&data) + describeMetric(metric).offset);
+     default:
+       return formatUnsigned(out, value);
+   }
+ }
+ 
+ // SENSOR_ROWS entries the host has reported, in order; returns how many
+ uint8_t reportedSensors(const HostSlot& slot, uint8_t* rows) {
+   uint8_t count = 0;
+   for (uint8_t i = 0; i < SENSOR_ROW_COUNT; i++) {
+     if (slot.reported & (1ul << SENSOR_ROWS[i].metric)) {
+       rows[count++] = i;
+     }
+   }
+   return count;
+ }
+ 
+ uint8_t pageViews(DisplayMode mode) {
+   const HostSlot& slot = hosts[currentHost];
+   uint8_t rows[SENSOR_ROW_COUNT];
+   switch (mode) {
+     case STATS:   return 2 * STAT_METRICS;
+     case SENSORS: return (reportedSensors(slot, rows) + 1) / 2;
+     case CORES:   return (slot.data.cores.count + CORES_PER_VIEW - 1) / CORES_PER_VIEW;
+     default:      return 1;
+   }
+ }
+ 
+ // Fields the page on screen is formatted from; HISTORY and STATS show one
+ // metric per view
+ FieldMask pageInputs(DisplayMode mode) {
+   switch (mode) {
+     case DATE_TIME: return localClock.valid() ? 0 : PAGE_INPUTS[mode];
+     case HISTORY:   return 1ul << HISTORY_SOURCES[historyMetric];
+     case STATS:     return 1ul << STAT_SOURCES[pageView % STAT_METRICS];
+     default:        return PAGE_INPUTS[mode];
+   }
+ }
+ 
+ // Step through the views of the page on screen. STATS extremes also age out
+ // of the window between frames, so its views are redrawn even if only one.
+ void updatePageView() {
+   if (millis() - pageViewSince < PAGE_ROTATE_MS) {
+     return;
+   }
+   uint8_t views = pageViews(currentMode);
+   if (views <= 1 && currentMode != STATS) {
+     return;
+   }
+   pageView = (pageView + 1) % views;
+   pageViewSince = millis();
+   displayDirty = true;
+ }
+ 
+ // Bottom row of the CORES page: one core per column from `first`, as bars of 0-8 pixel rows
+ void drawCoreBars(const SystemData& data, uint8_t first) {
+   for (uint8_t col = 0; col < CORES_PER_VIEW; col++) {
+     uint8_t core = first + col;
+     uint8_t rows = core < data.cores.count ? (data.cores.load[core] * 8 + 50 * CORE_SCALE) / (100 * CORE_SCALE) : 0;
+     if (rows == 0) {
+       frameBuffer.setCell(col, PAGE_TOP + 1, core < data.cores.count ? '_' : ' ');
+     } else if (rows == 8) {
+       frameBuffer.setCell(col, PAGE_TOP + 1, FULL_BLOCK);
+     } else {
+       frameBuffer.setCell(col, PAGE_TOP + 1, glyphCache.code(GLYPH_VBAR_1 + rows - 1));
+     }
+   }
+ }
+ 
+ // Sweep-style sparkline on the bottom page row: each sample keeps its column and the column
+ // after the newest one is left blank, so a new sample only changes two cells
+ void drawSparkline(const HistoryRing<HISTORY_CAPACITY>& ring) {
+   constexpr uint8_t columns = DISPLAY_COLS;
+   uint8_t newestCol = (ring.pushed() + columns - 1) % columns;
+   
+   for (uint8_t col = 0; col < columns; col++) {
+     uint8_t age = (newestCol + columns - col) % columns;
+     if (age == columns - 1 || age >= ring.size()) {
+       frameBuffer.setCell(col, PAGE_TOP + 1, ' ');
+       continue;
+     }
+     
+     uint8_t rows = (ring.fromNewest(age) * 8 + 127) / 255;  // 0-8 lit pixel rows
+     if (rows == 0) {
+       frameBuffer.setCell(col, PAGE_TOP + 1, ' ');
+     } else if (rows == 8) {
+       frameBuffer.setCell(col, PAGE_TOP + 1, FULL_BLOCK);
+     } else {
+       frameBuffer.setCell(col, PAGE_TOP + 1, glyphCache.code(GLYPH_VBAR_1 + rows - 1));
+     }
+   }
+ }
+ 
+ void resetStage(JsonStage& stage) {
+   memset(&stage, 0, sizeof(stage));
+ }
+ 
+ // Stage one value from a JSON object; unknown keys are ignored. Keys are
+ // matched by their hash, so no strings are compared per value.
+ void onJsonValue(const JsonStreamParser& parser, void* context) {
+   JsonStage& stage = *static_cast<JsonStage*>(context);
+   uint32_t key = parser.pathKey();
+   
+   if (parser.type() == JSON_BOOL) {
+     switch (key) {
+       case jsonPathKey("delta"):        stage.delta = parser.boolean(); break;
+       case jsonPathKey("clock.hour12"): stage.clock.hour12 = parser.boolean(); break;
+       default:                          break;
+     }
+     return;
+   }
+   
+   if (parser.type() == JSON_NUMBER) {
+     switch (key) {
+       case jsonPathKey("host"):
+         stage.host = parser.scaled(1);
+         return;
+       case jsonPathKey("seq"):
+         stage.tag.seq = static_cast<uint32_t>(parser.scaled64(1));
+         stage.tagged = true;
+         return;
+       case jsonPathKey("sent"):
+         stage.tag.sentUs = static_cast<uint32_t>(parser.scaled64(1));
+         return;
+       
+       // Epoch seconds, with a fraction for sub-second precision
+       case jsonPathKey("clock.epoch"): {
+         int64_t ms = parser.scaled64(1000);
+         if (ms >= 0 && ms / 1000 <= UINT32_MAX) {
+           stage.clock.epoch = static_cast<uint32_t>(ms / 1000);
+           stage.clock.millis = ms % 1000;
+           stage.hasClock = true;
+         }
+         return;
+       }
+       case jsonPathKey("clock.offset"):
+         stage.clock.offsetMinutes = constrain(parser.scaled(1), -24 * 60, 24 * 60);
+         return;
+       
+       default:
+         break;
+     }
+   } else if (parser.type() != JSON_STRING) {
+     return;
+   }
+   
+   int8_t metric = findMetric(key);
+   if (metric < 0) {
+     return;
+   }
+   const MetricDesc& desc = describeMetric(metric);
+   switch (desc.type) {
+     case TYPE_TEXT2:
+       if (parser.type() != JSON_STRING) {
+         return;
+       }
+       strlcpy(stage.data.datetime.period, parser.text(), sizeof(stage.data.datetime.period));
+       break;
+     case TYPE_CORES:
+       // "cores": [12.5, 3.0, ...], one element per core
+       if (parser.type() != JSON_NUMBER || parser.index() < 0) {
+         return;
+       }
+       writeCoreLoad(stage.data, min<int16_t>(parser.index(), MAX_CORES), parser.scaled(CORE_SCALE));
+       break;
+     default:
+       if (parser.type() != JSON_NUMBER) {
+         return;
+       }
+       writeMetric(stage.data, metric, parser.scaled(desc.scale));
+       break;
+   }
+   stage.fields |= 1ul << metric;
+ }
+ 
+ // Apply a complete JSON object to its host
+ bool commitJson(JsonStage& stage, uint8_t& host) {
+   if (stage.host < 0 || stage.host >= MAX_HOSTS) {
+     postMessage(F("JSON parse error: host ID out of range"));
+     return false;
+   }
+   host = stage.host;
+   const SystemData& target = latestHostData(host);
+ 
+   // Use temporary variables to ensure atomic updates
+   SystemData tempData;
+   
+   // A delta frame patches the current data, anything else replaces it
+   if (stage.delta) {
+     memcpy(&tempData, &target, sizeof(SystemData));
+   } else {
+     memset(&tempData, 0, sizeof(SystemData));
+     strcpy(tempData.datetime.period, "??");
+   }
+   copyFields(tempData, stage.data, stage.fields);
    
    // Atomic update of the system data
-   memcpy(&sysData, &tempData, sizeof(SystemData));
+   storeHostData(host, tempData, stage.fields);
    
    return true;
- }
\ No newline at end of file
+ }
+ 
+ bool applyBinaryFrame(const BinaryFrameDecoder& frame, uint8_t& host) {
+   host = frame.hostId();
+   if (host >= MAX_HOSTS) {
+     postMessage(F("Binary frame error: host ID out of range"));
+     return false;
+   }
+   // Same atomic update as the JSON path; a delta starts from the current data
+   SystemData tempData;
+   memcpy(&tempData, &latestHostData(host), sizeof(SystemData));
+   FieldMask mask = FIELD_SNAPSHOT;
+   
+   switch (frame.kind()) {
+     case FRAME_SNAPSHOT:
+       if (!decodeSnapshotV1(frame.payload(), frame.payloadLength(), tempData)) {
+         postMessage(F("Binary frame error: short snapshot"));
+         return false;
+       }
+       break;
+ 
+     case FRAME_DELTA: {
+       uint16_t snapshotMask;
+       if (!decodeDeltaV1(frame.payload(), frame.payloadLength(), tempData, snapshotMask)) {
+         postMessage(F("Binary frame error: short delta"));
+         return false;
+       }
+       mask = snapshotMask;
+       break;
+     }
+ 
+     case FRAME_METRICS:
+       if (!decodeMetrics(frame.payload(), frame.payloadLength(), tempData, mask)) {
+         postMessage(F("Binary frame error: bad metrics"));
+         return false;
+       }
+       break;
+ 
+     default:
+       postMessage(F("Binary frame error: unknown kind"));
+       return false;
+   }
+ 
+   if ((mask & FIELD_PERIOD) && !tempData.datetime.period[0]) {
+     strcpy(tempData.datetime.period, "??");
+   }
+   storeHostData(host, tempData, mask);
+ 
+   return true;
+ }
+ 
+ // The data the next delta for a host patches
+ const SystemData& latestHostData(uint8_t host) {
+ #ifdef INGEST_TASK
+   return ingestHosts[host].data;
+ #else
+   return hosts[host].data;
+ #endif
+ }
+ 
+ // Store a frame's result: straight into the host slot on one core, or
+ // published for loop() to take over on two
+ void storeHostData(uint8_t host, const SystemData& data, FieldMask fields) {
+ #ifdef INGEST_TASK
+   HostFrame& latest = ingestHosts[host];
+   memcpy(&latest.data, &data, sizeof(SystemData));
+   latest.reported |= fields;
+   hostFrames[host].back() = latest;
+   hostFrames[host].publish();
+ #else
+   applyHostData(host, data, fields);
+ #endif
+ }
+ 
+ // Replace a host's data with a frame's result, noting what it changed.
+ // A field reported for the first time counts as changed even if it is 0,
+ // since it adds a row to the SENSORS page.
+ void applyHostData(uint8_t host, const SystemData& data, FieldMask fields) {
+   HostSlot& slot = hosts[host];
+   slot.changed = changedFields(slot.data, data) | (fields & ~slot.reported);
+   slot.reported |= fields;
+   memcpy(&slot.data, &data, sizeof(SystemData));
+ }
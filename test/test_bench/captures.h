@@ -0,0 +1,217 @@
+/*
+ *  GearPulse - replay captures for the native benchmark
+ *  --------------------------------------
+ *  One minute of one-second samples from a desktop under changing load, in
+ *  both wire formats: one JSON object per line as the desktop app sends
+ *  them, and the same samples as binary frames the way host/ sends them, a
+ *  snapshot every ten samples with deltas in between. A download burst
+ *  runs from sample 20 to 35, so the NETWORK page changes units.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t CAPTURE_SAMPLES = 60;
+
+const char CAPTURE_JSON[] = R"(
+{"cpu":{"load":12.1,"temp":51.5},"gpu":{"load":5.1,"temp":46.9},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":28045.0,"download":178200.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":1,"period":"AM"}}
+{"cpu":{"load":11.6,"temp":51.5},"gpu":{"load":6.6,"temp":46.2},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":21758.0,"download":165726.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":2,"period":"AM"}}
+{"cpu":{"load":9.6,"temp":50.6},"gpu":{"load":3.9,"temp":45.3},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":65264.0,"download":164068.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":3,"period":"AM"}}
+{"cpu":{"load":6.6,"temp":50.1},"gpu":{"load":7.5,"temp":45.3},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":67980.0,"download":164068.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":4,"period":"AM"}}
+{"cpu":{"load":2.0,"temp":49.3},"gpu":{"load":3.4,"temp":44.3},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":20051.0,"download":157505.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":5,"period":"AM"}}
+{"cpu":{"load":2.0,"temp":48.2},"gpu":{"load":0.0,"temp":43.9},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":21992.0,"download":149630.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":6,"period":"AM"}}
+{"cpu":{"load":3.8,"temp":47.6},"gpu":{"load":3.5,"temp":43.0},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":29992.0,"download":148134.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":7,"period":"AM"}}
+{"cpu":{"load":2.0,"temp":46.8},"gpu":{"load":0.0,"temp":42.5},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":57055.0,"download":143690.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":8,"period":"AM"}}
+{"cpu":{"load":8.3,"temp":45.8},"gpu":{"load":2.3,"temp":41.8},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":47577.0,"download":137942.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":9,"period":"AM"}}
+{"cpu":{"load":2.5,"temp":44.6},"gpu":{"load":2.3,"temp":41.5},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":26857.0,"download":133804.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":10,"period":"AM"}}
+{"cpu":{"load":8.6,"temp":44.4},"gpu":{"load":0.0,"temp":41.3},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":63295.0,"download":145846.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":11,"period":"AM"}}
+{"cpu":{"load":5.7,"temp":43.7},"gpu":{"load":0.2,"temp":40.3},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":12033.0,"download":150222.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":12,"period":"AM"}}
+{"cpu":{"load":5.1,"temp":42.7},"gpu":{"load":3.8,"temp":40.1},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":44588.0,"download":160737.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":13,"period":"AM"}}
+{"cpu":{"load":4.0,"temp":42.0},"gpu":{"load":3.4,"temp":39.4},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":59148.0,"download":162345.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":14,"period":"AM"}}
+{"cpu":{"load":4.2,"temp":41.7},"gpu":{"load":0.1,"temp":38.5},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":21606.0,"download":147734.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":15,"period":"AM"}}
+{"cpu":{"load":9.4,"temp":40.9},"gpu":{"load":7.3,"temp":37.6},"ram":{"total":15.9,"used":7.40,"usagePercent":46.6},"network":{"upload":54002.0,"download":135915.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":16,"period":"AM"}}
+{"cpu":{"load":19.6,"temp":40.1},"gpu":{"load":10.5,"temp":37.7},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":30282.0,"download":134556.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":17,"period":"AM"}}
+{"cpu":{"load":23.9,"temp":40.1},"gpu":{"load":10.2,"temp":37.7},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":52052.0,"download":130519.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":18,"period":"AM"}}
+{"cpu":{"load":20.6,"temp":39.4},"gpu":{"load":15.3,"temp":37.1},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":60394.0,"download":131824.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":19,"period":"AM"}}
+{"cpu":{"load":14.3,"temp":38.9},"gpu":{"load":10.7,"temp":36.4},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":46399.0,"download":129188.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":20,"period":"AM"}}
+{"cpu":{"load":13.2,"temp":38.8},"gpu":{"load":5.0,"temp":35.7},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":43111.0,"download":4944000.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":21,"period":"AM"}}
+{"cpu":{"load":19.3,"temp":38.1},"gpu":{"load":0.0,"temp":34.7},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":46610.0,"download":4894560.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":22,"period":"AM"}}
+{"cpu":{"load":26.1,"temp":38.1},"gpu":{"load":4.8,"temp":34.2},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":63959.0,"download":4845614.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":23,"period":"AM"}}
+{"cpu":{"load":22.0,"temp":37.7},"gpu":{"load":10.0,"temp":34.0},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":42225.0,"download":4554877.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":24,"period":"AM"}}
+{"cpu":{"load":23.0,"temp":37.6},"gpu":{"load":5.5,"temp":33.8},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":23026.0,"download":4873718.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":25,"period":"AM"}}
+{"cpu":{"load":32.6,"temp":37.4},"gpu":{"load":9.0,"temp":33.7},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":15606.0,"download":4873718.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":26,"period":"AM"}}
+{"cpu":{"load":38.2,"temp":37.4},"gpu":{"load":16.8,"temp":33.4},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":41822.0,"download":5166142.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":27,"period":"AM"}}
+{"cpu":{"load":29.2,"temp":36.8},"gpu":{"load":14.2,"temp":33.0},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":27556.0,"download":5579433.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":28,"period":"AM"}}
+{"cpu":{"load":36.9,"temp":36.7},"gpu":{"load":20.5,"temp":32.3},"ram":{"total":15.9,"used":7.40,"usagePercent":46.6},"network":{"upload":36181.0,"download":5021490.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":29,"period":"AM"}}
+{"cpu":{"load":30.3,"temp":36.4},"gpu":{"load":21.2,"temp":32.1},"ram":{"total":15.9,"used":7.40,"usagePercent":46.6},"network":{"upload":39909.0,"download":5423209.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":30,"period":"AM"}}
+{"cpu":{"load":38.8,"temp":36.7},"gpu":{"load":19.4,"temp":31.4},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":15509.0,"download":5585905.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":31,"period":"AM"}}
+{"cpu":{"load":39.6,"temp":37.0},"gpu":{"load":15.9,"temp":31.5},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":21660.0,"download":5753482.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":32,"period":"AM"}}
+{"cpu":{"load":30.7,"temp":36.7},"gpu":{"load":23.5,"temp":31.5},"ram":{"total":15.9,"used":7.39,"usagePercent":46.5},"network":{"upload":40317.0,"download":5580878.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":33,"period":"AM"}}
+{"cpu":{"load":38.7,"temp":37.0},"gpu":{"load":19.5,"temp":31.2},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":39567.0,"download":5859922.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":34,"period":"AM"}}
+{"cpu":{"load":48.6,"temp":37.2},"gpu":{"load":26.0,"temp":31.5},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":21570.0,"download":6387315.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":35,"period":"AM"}}
+{"cpu":{"load":42.8,"temp":37.0},"gpu":{"load":22.4,"temp":30.9},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":28728.0,"download":92150.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":36,"period":"AM"}}
+{"cpu":{"load":52.7,"temp":37.4},"gpu":{"load":19.6,"temp":30.6},"ram":{"total":15.9,"used":7.39,"usagePercent":46.5},"network":{"upload":16575.0,"download":93993.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":37,"period":"AM"}}
+{"cpu":{"load":45.7,"temp":37.2},"gpu":{"load":22.1,"temp":30.8},"ram":{"total":15.9,"used":7.39,"usagePercent":46.5},"network":{"upload":15038.0,"download":89293.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":38,"period":"AM"}}
+{"cpu":{"load":45.5,"temp":36.8},"gpu":{"load":26.6,"temp":30.5},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":12215.0,"download":89293.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":39,"period":"AM"}}
+{"cpu":{"load":46.5,"temp":37.3},"gpu":{"load":30.7,"temp":30.6},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":61988.0,"download":97329.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":40,"period":"AM"}}
+{"cpu":{"load":41.2,"temp":37.3},"gpu":{"load":24.4,"temp":31.0},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":53174.0,"download":100249.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":41,"period":"AM"}}
+{"cpu":{"load":47.7,"temp":37.8},"gpu":{"load":22.9,"temp":30.6},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":33646.0,"download":100249.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":42,"period":"AM"}}
+{"cpu":{"load":41.2,"temp":37.7},"gpu":{"load":24.3,"temp":30.4},"ram":{"total":15.9,"used":7.40,"usagePercent":46.5},"network":{"upload":26107.0,"download":109272.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":43,"period":"AM"}}
+{"cpu":{"load":36.7,"temp":37.6},"gpu":{"load":24.2,"temp":30.1},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":56912.0,"download":98344.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":44,"period":"AM"}}
+{"cpu":{"load":34.9,"temp":37.4},"gpu":{"load":25.4,"temp":30.4},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":39501.0,"download":88510.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":45,"period":"AM"}}
+{"cpu":{"load":35.3,"temp":37.0},"gpu":{"load":31.6,"temp":30.8},"ram":{"total":15.9,"used":7.40,"usagePercent":46.6},"network":{"upload":31904.0,"download":90280.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":46,"period":"AM"}}
+{"cpu":{"load":29.3,"temp":36.4},"gpu":{"load":37.7,"temp":30.6},"ram":{"total":15.9,"used":7.40,"usagePercent":46.6},"network":{"upload":62221.0,"download":96600.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":47,"period":"AM"}}
+{"cpu":{"load":26.4,"temp":35.8},"gpu":{"load":44.8,"temp":31.0},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":63650.0,"download":104328.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":48,"period":"AM"}}
+{"cpu":{"load":29.1,"temp":35.9},"gpu":{"load":45.4,"temp":31.3},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":12192.0,"download":97025.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":49,"period":"AM"}}
+{"cpu":{"load":36.8,"temp":35.3},"gpu":{"load":40.2,"temp":31.7},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":12268.0,"download":106727.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":50,"period":"AM"}}
+{"cpu":{"load":38.3,"temp":35.6},"gpu":{"load":38.9,"temp":31.4},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":14024.0,"download":109929.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":51,"period":"AM"}}
+{"cpu":{"load":45.6,"temp":35.7},"gpu":{"load":45.9,"temp":31.5},"ram":{"total":15.9,"used":7.42,"usagePercent":46.7},"network":{"upload":43884.0,"download":100035.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":52,"period":"AM"}}
+{"cpu":{"load":50.3,"temp":36.3},"gpu":{"load":53.1,"temp":31.8},"ram":{"total":15.9,"used":7.41,"usagePercent":46.6},"network":{"upload":31298.0,"download":108038.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":53,"period":"AM"}}
+{"cpu":{"load":60.4,"temp":36.6},"gpu":{"load":47.6,"temp":31.7},"ram":{"total":15.9,"used":7.42,"usagePercent":46.6},"network":{"upload":16858.0,"download":113440.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":54,"period":"AM"}}
+{"cpu":{"load":67.5,"temp":37.5},"gpu":{"load":42.3,"temp":31.8},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":50022.0,"download":110037.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":55,"period":"AM"}}
+{"cpu":{"load":77.1,"temp":38.5},"gpu":{"load":47.6,"temp":32.0},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":22686.0,"download":101234.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":56,"period":"AM"}}
+{"cpu":{"load":68.1,"temp":38.7},"gpu":{"load":45.3,"temp":32.0},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":62686.0,"download":97185.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":57,"period":"AM"}}
+{"cpu":{"load":69.0,"temp":39.5},"gpu":{"load":41.1,"temp":31.8},"ram":{"total":15.9,"used":7.43,"usagePercent":46.8},"network":{"upload":30703.0,"download":98157.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":58,"period":"AM"}}
+{"cpu":{"load":65.0,"temp":40.1},"gpu":{"load":48.4,"temp":32.4},"ram":{"total":15.9,"used":7.43,"usagePercent":46.7},"network":{"upload":20518.0,"download":88341.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":41,"second":59,"period":"AM"}}
+{"cpu":{"load":59.7,"temp":40.1},"gpu":{"load":56.8,"temp":33.0},"ram":{"total":15.9,"used":7.44,"usagePercent":46.8},"network":{"upload":18873.0,"download":84807.0},"date":{"year":2024,"month":5,"day":17},"time":{"hour":9,"minute":42,"second":0,"period":"AM"}}
+)";
+
+const uint8_t CAPTURE_BINARY[] = {
+  0xA5, 0x21, 0x01, 0x01, 0x79, 0x00, 0x03, 0x02, 0x33, 0x00, 0xD5, 0x01,
+  0x36, 0x06, 0xE7, 0x02, 0xD3, 0x01, 0x8D, 0x6D, 0x00, 0x00, 0x18, 0xB8,
+  0x02, 0x00, 0xE8, 0x07, 0x05, 0x11, 0x09, 0x29, 0x01, 0x41, 0x4D, 0xEC,
+  0x91, 0xA5, 0x15, 0x01, 0x02, 0xAD, 0x41, 0x74, 0x00, 0x42, 0x00, 0xCE,
+  0x01, 0xE6, 0x02, 0xFE, 0x54, 0x00, 0x00, 0x5E, 0x87, 0x02, 0x00, 0x02,
+  0xB2, 0x4C, 0xA5, 0x17, 0x01, 0x02, 0xCF, 0x41, 0x60, 0x00, 0xFA, 0x01,
+  0x27, 0x00, 0xC5, 0x01, 0xD2, 0x01, 0xF0, 0xFE, 0x00, 0x00, 0xE4, 0x80,
+  0x02, 0x00, 0x03, 0xD0, 0x1A, 0xA5, 0x11, 0x01, 0x02, 0xA7, 0x40, 0x42,
+  0x00, 0xF5, 0x01, 0x4B, 0x00, 0xE5, 0x02, 0x8C, 0x09, 0x01, 0x00, 0x04,
+  0xFB, 0x15, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x14, 0x00, 0xED, 0x01,
+  0x22, 0x00, 0xBB, 0x01, 0x53, 0x4E, 0x00, 0x00, 0x41, 0x67, 0x02, 0x00,
+  0x05, 0x82, 0x12, 0xA5, 0x15, 0x01, 0x02, 0xAE, 0x41, 0xE2, 0x01, 0x00,
+  0x00, 0xB7, 0x01, 0xE6, 0x02, 0xE8, 0x55, 0x00, 0x00, 0x7E, 0x48, 0x02,
+  0x00, 0x06, 0xE9, 0x33, 0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41, 0x26, 0x00,
+  0xDC, 0x01, 0x23, 0x00, 0xAE, 0x01, 0xE5, 0x02, 0x28, 0x75, 0x00, 0x00,
+  0xA6, 0x42, 0x02, 0x00, 0x07, 0x00, 0xC2, 0xA5, 0x19, 0x01, 0x02, 0xEF,
+  0x41, 0x14, 0x00, 0xD4, 0x01, 0x00, 0x00, 0xA9, 0x01, 0xE6, 0x02, 0xD3,
+  0x01, 0xDF, 0xDE, 0x00, 0x00, 0x4A, 0x31, 0x02, 0x00, 0x08, 0xA2, 0xF6,
+  0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0x53, 0x00, 0xCA, 0x01, 0x17, 0x00,
+  0xA2, 0x01, 0xE5, 0x02, 0xD2, 0x01, 0xD9, 0xB9, 0x00, 0x00, 0xD6, 0x1A,
+  0x02, 0x00, 0x09, 0xED, 0x9B, 0xA5, 0x17, 0x01, 0x02, 0xEB, 0x41, 0x19,
+  0x00, 0xBE, 0x01, 0x9F, 0x01, 0xE6, 0x02, 0xD3, 0x01, 0xE9, 0x68, 0x00,
+  0x00, 0xAC, 0x0A, 0x02, 0x00, 0x0A, 0x7E, 0x96, 0xA5, 0x21, 0x01, 0x01,
+  0x56, 0x00, 0xBC, 0x01, 0x00, 0x00, 0x9D, 0x01, 0x36, 0x06, 0xE7, 0x02,
+  0xD3, 0x01, 0x3F, 0xF7, 0x00, 0x00, 0xB6, 0x39, 0x02, 0x00, 0xE8, 0x07,
+  0x05, 0x11, 0x09, 0x29, 0x0B, 0x41, 0x4D, 0x37, 0x65, 0xA5, 0x17, 0x01,
+  0x02, 0xAF, 0x41, 0x39, 0x00, 0xB5, 0x01, 0x02, 0x00, 0x93, 0x01, 0xE6,
+  0x02, 0x01, 0x2F, 0x00, 0x00, 0xCE, 0x4A, 0x02, 0x00, 0x0C, 0xB3, 0xA0,
+  0xA5, 0x17, 0x01, 0x02, 0xCF, 0x41, 0x33, 0x00, 0xAB, 0x01, 0x26, 0x00,
+  0x91, 0x01, 0xD2, 0x01, 0x2C, 0xAE, 0x00, 0x00, 0xE1, 0x73, 0x02, 0x00,
+  0x0D, 0xC2, 0x03, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x28, 0x00, 0xA4,
+  0x01, 0x22, 0x00, 0x8A, 0x01, 0x0C, 0xE7, 0x00, 0x00, 0x29, 0x7A, 0x02,
+  0x00, 0x0E, 0x8F, 0xB3, 0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41, 0x2A, 0x00,
+  0xA1, 0x01, 0x01, 0x00, 0x81, 0x01, 0xE5, 0x02, 0x66, 0x54, 0x00, 0x00,
+  0x16, 0x41, 0x02, 0x00, 0x0F, 0x54, 0x8C, 0xA5, 0x17, 0x01, 0x02, 0xAF,
+  0x41, 0x5E, 0x00, 0x99, 0x01, 0x49, 0x00, 0x78, 0x01, 0xE4, 0x02, 0xF2,
+  0xD2, 0x00, 0x00, 0xEB, 0x12, 0x02, 0x00, 0x10, 0xA7, 0xA1, 0xA5, 0x17,
+  0x01, 0x02, 0xCF, 0x41, 0xC4, 0x00, 0x91, 0x01, 0x69, 0x00, 0x79, 0x01,
+  0xD1, 0x01, 0x4A, 0x76, 0x00, 0x00, 0x9C, 0x0D, 0x02, 0x00, 0x11, 0xCF,
+  0xFF, 0xA5, 0x11, 0x01, 0x02, 0x85, 0x41, 0xEF, 0x00, 0x66, 0x00, 0x54,
+  0xCB, 0x00, 0x00, 0xD7, 0xFD, 0x01, 0x00, 0x12, 0xF5, 0x84, 0xA5, 0x19,
+  0x01, 0x02, 0xEF, 0x41, 0xCE, 0x00, 0x8A, 0x01, 0x99, 0x00, 0x73, 0x01,
+  0xE5, 0x02, 0xD2, 0x01, 0xEA, 0xEB, 0x00, 0x00, 0xF0, 0x02, 0x02, 0x00,
+  0x13, 0x10, 0x61, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x8F, 0x00, 0x85,
+  0x01, 0x6B, 0x00, 0x6C, 0x01, 0x3F, 0xB5, 0x00, 0x00, 0xA4, 0xF8, 0x01,
+  0x00, 0x14, 0x8E, 0xF8, 0xA5, 0x21, 0x01, 0x01, 0x84, 0x00, 0x84, 0x01,
+  0x32, 0x00, 0x65, 0x01, 0x36, 0x06, 0xE5, 0x02, 0xD2, 0x01, 0x67, 0xA8,
+  0x00, 0x00, 0x80, 0x70, 0x4B, 0x00, 0xE8, 0x07, 0x05, 0x11, 0x09, 0x29,
+  0x15, 0x41, 0x4D, 0x6D, 0x6A, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0xC1,
+  0x00, 0x7D, 0x01, 0x00, 0x00, 0x5B, 0x01, 0x12, 0xB6, 0x00, 0x00, 0x60,
+  0xAF, 0x4A, 0x00, 0x16, 0xA7, 0xE8, 0xA5, 0x13, 0x01, 0x02, 0x8D, 0x41,
+  0x05, 0x01, 0x30, 0x00, 0x56, 0x01, 0xD7, 0xF9, 0x00, 0x00, 0x2E, 0xF0,
+  0x49, 0x00, 0x17, 0xB7, 0xB8, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0xDC,
+  0x00, 0x79, 0x01, 0x64, 0x00, 0x54, 0x01, 0xF1, 0xA4, 0x00, 0x00, 0x7D,
+  0x80, 0x45, 0x00, 0x18, 0xF6, 0x93, 0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41,
+  0xE6, 0x00, 0x78, 0x01, 0x37, 0x00, 0x52, 0x01, 0xE6, 0x02, 0xF2, 0x59,
+  0x00, 0x00, 0xF6, 0x5D, 0x4A, 0x00, 0x19, 0xFC, 0xC2, 0xA5, 0x11, 0x01,
+  0x02, 0x8F, 0x40, 0x46, 0x01, 0x76, 0x01, 0x5A, 0x00, 0x51, 0x01, 0xF6,
+  0x3C, 0x00, 0x00, 0x1A, 0xE6, 0x12, 0xA5, 0x15, 0x01, 0x02, 0xAD, 0x41,
+  0x7E, 0x01, 0xA8, 0x00, 0x4E, 0x01, 0xE5, 0x02, 0x5E, 0xA3, 0x00, 0x00,
+  0x3E, 0xD4, 0x4E, 0x00, 0x1B, 0xBF, 0x88, 0xA5, 0x15, 0x01, 0x02, 0x8F,
+  0x41, 0x24, 0x01, 0x70, 0x01, 0x8E, 0x00, 0x4A, 0x01, 0xA4, 0x6B, 0x00,
+  0x00, 0xA9, 0x22, 0x55, 0x00, 0x1C, 0xD2, 0xC9, 0xA5, 0x17, 0x01, 0x02,
+  0xAF, 0x41, 0x71, 0x01, 0x6F, 0x01, 0xCD, 0x00, 0x43, 0x01, 0xE4, 0x02,
+  0x55, 0x8D, 0x00, 0x00, 0x32, 0x9F, 0x4C, 0x00, 0x1D, 0xAF, 0x74, 0xA5,
+  0x15, 0x01, 0x02, 0x8F, 0x41, 0x2F, 0x01, 0x6C, 0x01, 0xD4, 0x00, 0x41,
+  0x01, 0xE5, 0x9B, 0x00, 0x00, 0x69, 0xC0, 0x52, 0x00, 0x1E, 0x8A, 0x9C,
+  0xA5, 0x21, 0x01, 0x01, 0x84, 0x01, 0x6F, 0x01, 0xC2, 0x00, 0x3A, 0x01,
+  0x36, 0x06, 0xE5, 0x02, 0xD2, 0x01, 0x95, 0x3C, 0x00, 0x00, 0xF1, 0x3B,
+  0x55, 0x00, 0xE8, 0x07, 0x05, 0x11, 0x09, 0x29, 0x1F, 0x41, 0x4D, 0x1A,
+  0x5E, 0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0x8C, 0x01, 0x72, 0x01, 0x9F,
+  0x00, 0x3B, 0x01, 0xE4, 0x02, 0xD1, 0x01, 0x9C, 0x54, 0x00, 0x00, 0x8A,
+  0xCA, 0x57, 0x00, 0x20, 0x68, 0x78, 0xA5, 0x15, 0x01, 0x02, 0xA7, 0x41,
+  0x33, 0x01, 0x6F, 0x01, 0xEB, 0x00, 0xE3, 0x02, 0x7D, 0x9D, 0x00, 0x00,
+  0x4E, 0x28, 0x55, 0x00, 0x21, 0x8D, 0xF4, 0xA5, 0x17, 0x01, 0x02, 0xAF,
+  0x41, 0x83, 0x01, 0x72, 0x01, 0xC3, 0x00, 0x38, 0x01, 0xE4, 0x02, 0x8F,
+  0x9A, 0x00, 0x00, 0x52, 0x6A, 0x59, 0x00, 0x22, 0x16, 0xB6, 0xA5, 0x15,
+  0x01, 0x02, 0x8F, 0x41, 0xE6, 0x01, 0x74, 0x01, 0x04, 0x01, 0x3B, 0x01,
+  0x42, 0x54, 0x00, 0x00, 0x73, 0x76, 0x61, 0x00, 0x23, 0x64, 0x3D, 0xA5,
+  0x15, 0x01, 0x02, 0x8F, 0x41, 0xAC, 0x01, 0x72, 0x01, 0xE0, 0x00, 0x35,
+  0x01, 0x38, 0x70, 0x00, 0x00, 0xF6, 0x67, 0x01, 0x00, 0x24, 0x3B, 0x15,
+  0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41, 0x0F, 0x02, 0x76, 0x01, 0xC4, 0x00,
+  0x32, 0x01, 0xE3, 0x02, 0xBF, 0x40, 0x00, 0x00, 0x29, 0x6F, 0x01, 0x00,
+  0x25, 0x9D, 0xF6, 0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41, 0xC9, 0x01, 0x74,
+  0x01, 0xDD, 0x00, 0x34, 0x01, 0xE4, 0x02, 0xBE, 0x3A, 0x00, 0x00, 0xCD,
+  0x5C, 0x01, 0x00, 0x26, 0x7C, 0xFE, 0xA5, 0x11, 0x01, 0x02, 0x8F, 0x40,
+  0xC7, 0x01, 0x70, 0x01, 0x0A, 0x01, 0x31, 0x01, 0xB7, 0x2F, 0x00, 0x00,
+  0x27, 0x83, 0x37, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0xD1, 0x01, 0x75,
+  0x01, 0x33, 0x01, 0x32, 0x01, 0x24, 0xF2, 0x00, 0x00, 0x31, 0x7C, 0x01,
+  0x00, 0x28, 0xE9, 0xFB, 0xA5, 0x21, 0x01, 0x01, 0x9C, 0x01, 0x75, 0x01,
+  0xF4, 0x00, 0x36, 0x01, 0x36, 0x06, 0xE4, 0x02, 0xD1, 0x01, 0xB6, 0xCF,
+  0x00, 0x00, 0x99, 0x87, 0x01, 0x00, 0xE8, 0x07, 0x05, 0x11, 0x09, 0x29,
+  0x29, 0x41, 0x4D, 0xC2, 0x46, 0xA5, 0x11, 0x01, 0x02, 0x8F, 0x40, 0xDD,
+  0x01, 0x7A, 0x01, 0xE5, 0x00, 0x32, 0x01, 0x6E, 0x83, 0x00, 0x00, 0x2A,
+  0x73, 0x09, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x9C, 0x01, 0x79, 0x01,
+  0xF3, 0x00, 0x30, 0x01, 0xFB, 0x65, 0x00, 0x00, 0xD8, 0xAA, 0x01, 0x00,
+  0x2B, 0xB3, 0xA7, 0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0x6F, 0x01, 0x78,
+  0x01, 0xF2, 0x00, 0x2D, 0x01, 0xE5, 0x02, 0xD2, 0x01, 0x50, 0xDE, 0x00,
+  0x00, 0x28, 0x80, 0x01, 0x00, 0x2C, 0xE3, 0x43, 0xA5, 0x15, 0x01, 0x02,
+  0x8F, 0x41, 0x5D, 0x01, 0x76, 0x01, 0xFE, 0x00, 0x30, 0x01, 0x4D, 0x9A,
+  0x00, 0x00, 0xBE, 0x59, 0x01, 0x00, 0x2D, 0x62, 0x1E, 0xA5, 0x17, 0x01,
+  0x02, 0xAF, 0x41, 0x61, 0x01, 0x72, 0x01, 0x3C, 0x01, 0x34, 0x01, 0xE4,
+  0x02, 0xA0, 0x7C, 0x00, 0x00, 0xA8, 0x60, 0x01, 0x00, 0x2E, 0x25, 0x46,
+  0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x25, 0x01, 0x6C, 0x01, 0x79, 0x01,
+  0x32, 0x01, 0x0D, 0xF3, 0x00, 0x00, 0x58, 0x79, 0x01, 0x00, 0x2F, 0xE0,
+  0x51, 0xA5, 0x17, 0x01, 0x02, 0xAF, 0x41, 0x08, 0x01, 0x66, 0x01, 0xC0,
+  0x01, 0x36, 0x01, 0xE5, 0x02, 0xA2, 0xF8, 0x00, 0x00, 0x88, 0x97, 0x01,
+  0x00, 0x30, 0x1E, 0xB6, 0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0x23, 0x01,
+  0x67, 0x01, 0xC6, 0x01, 0x39, 0x01, 0xE6, 0x02, 0xD3, 0x01, 0xA0, 0x2F,
+  0x00, 0x00, 0x01, 0x7B, 0x01, 0x00, 0x31, 0x6E, 0x9D, 0xA5, 0x17, 0x01,
+  0x02, 0xAF, 0x41, 0x70, 0x01, 0x61, 0x01, 0x92, 0x01, 0x3D, 0x01, 0xE7,
+  0x02, 0xEC, 0x2F, 0x00, 0x00, 0xE7, 0xA0, 0x01, 0x00, 0x32, 0xFB, 0x74,
+  0xA5, 0x21, 0x01, 0x01, 0x7F, 0x01, 0x64, 0x01, 0x85, 0x01, 0x3A, 0x01,
+  0x36, 0x06, 0xE6, 0x02, 0xD3, 0x01, 0xC8, 0x36, 0x00, 0x00, 0x69, 0xAD,
+  0x01, 0x00, 0xE8, 0x07, 0x05, 0x11, 0x09, 0x29, 0x33, 0x41, 0x4D, 0x52,
+  0x1C, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0xC8, 0x01, 0x65, 0x01, 0xCB,
+  0x01, 0x3B, 0x01, 0x6C, 0xAB, 0x00, 0x00, 0xC3, 0x86, 0x01, 0x00, 0x34,
+  0x64, 0x22, 0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0xF7, 0x01, 0x6B, 0x01,
+  0x13, 0x02, 0x3E, 0x01, 0xE5, 0x02, 0xD2, 0x01, 0x42, 0x7A, 0x00, 0x00,
+  0x06, 0xA6, 0x01, 0x00, 0x35, 0x0D, 0x77, 0xA5, 0x17, 0x01, 0x02, 0xAF,
+  0x41, 0x5C, 0x02, 0x6E, 0x01, 0xDC, 0x01, 0x3D, 0x01, 0xE6, 0x02, 0xDA,
+  0x41, 0x00, 0x00, 0x20, 0xBB, 0x01, 0x00, 0x36, 0xB1, 0x96, 0xA5, 0x19,
+  0x01, 0x02, 0xEF, 0x41, 0xA3, 0x02, 0x77, 0x01, 0xA7, 0x01, 0x3E, 0x01,
+  0xE7, 0x02, 0xD3, 0x01, 0x66, 0xC3, 0x00, 0x00, 0xD5, 0xAD, 0x01, 0x00,
+  0x37, 0xCF, 0x26, 0xA5, 0x15, 0x01, 0x02, 0x8F, 0x41, 0x03, 0x03, 0x81,
+  0x01, 0xDC, 0x01, 0x40, 0x01, 0x9E, 0x58, 0x00, 0x00, 0x72, 0x8B, 0x01,
+  0x00, 0x38, 0x43, 0xB2, 0xA5, 0x13, 0x01, 0x02, 0x87, 0x41, 0xA9, 0x02,
+  0x83, 0x01, 0xC5, 0x01, 0xDE, 0xF4, 0x00, 0x00, 0xA1, 0x7B, 0x01, 0x00,
+  0x39, 0xE6, 0x61, 0xA5, 0x19, 0x01, 0x02, 0xEF, 0x41, 0xB2, 0x02, 0x8B,
+  0x01, 0x9B, 0x01, 0x3E, 0x01, 0xE8, 0x02, 0xD4, 0x01, 0xEF, 0x77, 0x00,
+  0x00, 0x6D, 0x7F, 0x01, 0x00, 0x3A, 0x70, 0xD9, 0xA5, 0x19, 0x01, 0x02,
+  0xEF, 0x41, 0x8A, 0x02, 0x91, 0x01, 0xE4, 0x01, 0x44, 0x01, 0xE7, 0x02,
+  0xD3, 0x01, 0x26, 0x50, 0x00, 0x00, 0x15, 0x59, 0x01, 0x00, 0x3B, 0xCB,
+  0xCC, 0xA5, 0x18, 0x01, 0x02, 0xED, 0x61, 0x55, 0x02, 0x38, 0x02, 0x4A,
+  0x01, 0xE8, 0x02, 0xD4, 0x01, 0xB9, 0x49, 0x00, 0x00, 0x47, 0x4B, 0x01,
+  0x00, 0x2A, 0x00, 0x08, 0x26,
+};
@@ -0,0 +1,394 @@
+/*
+ *  GearPulse - native ingest and render benchmark
+ *  --------------------------------------
+ *  Runs the real firmware (src/main.cpp) against the NativeMock backend and
+ *  replays the captures in captures.h through ingest and every page. For
+ *  each stage it prints wall-clock ns per frame, heap allocations per frame
+ *  and LCD cells written per frame, the cells being counted by the HD44780
+ *  model at the far end of the I2C bus.
+ *
+ *  Timing is reported only, since it depends on the build machine. The
+ *  gates are the parts that don't: every frame applies, nothing allocates,
+ *  the panel ends up showing the right text, and the cell count per page
+ *  stays within its budget.
+ *
+ *    pio test -e native -v
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <BinaryFrame.h>
+#include <unity.h>
+
+#include <chrono>
+
+#include "captures.h"
+
+// Firmware entry points, from src/main.cpp
+void setup();
+void loop();
+void processSerialData();
+void updateDisplay();
+void changeDisplayMode();
+void sendStats(Print& out);
+
+const uint8_t PAGES = 8;  // CPU, MEMORY, NETWORK, DATE_TIME, HISTORY, STATS, SENSORS, CORES
+const char* const PAGE_NAMES[PAGES] = { "cpu", "memory", "network", "date", "history", "stats", "sensors", "cores" };
+
+// Passes over each capture, so short runs still give stable averages
+const uint8_t REPEATS = 20;
+
+// Most cells a page may write per sample; a full redraw of the 16x2 panel is 32
+const uint8_t PAGE_CELL_BUDGET[PAGES] = { 12, 8, 12, 6, 32, 32, 32, 32 };
+
+struct Measure {
+  uint64_t ns = 0;
+  uint32_t frames = 0;
+  uint32_t allocations = 0;
+  uint32_t cells = 0;
+
+  void report(const char* name) const {
+    printf("%-16s %6u frames %9.0f ns/frame %6.2f alloc/frame %6.2f cells/frame\n",
+           name, frames, frames ? double(ns) / frames : 0.0,
+           frames ? double(allocations) / frames : 0.0, frames ? double(cells) / frames : 0.0);
+  }
+};
+
+// Starts a stopwatch and snapshots the counters; stop() adds the difference
+class Span {
+ public:
+  explicit Span(Measure& measure)
+    : measure(measure), allocations(mockAllocations()), cells(mockLcd.cellsWritten()),
+      started(std::chrono::steady_clock::now()) {}
+
+  void stop() {
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    measure.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    measure.allocations += mockAllocations() - allocations;
+    measure.cells += mockLcd.cellsWritten() - cells;
+  }
+
+ private:
+  Measure& measure;
+  uint32_t allocations;
+  uint32_t cells;
+  std::chrono::steady_clock::time_point started;
+};
+
+// Collects a @stats record so the firmware's own counters can be checked
+class StatsLine : public Print {
+ public:
+  size_t write(uint8_t c) override {
+    if (length < sizeof(text) - 1) {
+      text[length++] = c;
+      text[length] = '\0';
+    }
+    return 1;
+  }
+
+  uint32_t field(const char* name) const {
+    char key[16];
+    snprintf(key, sizeof(key), " %s=", name);
+    const char* at = strstr(text, key);
+    return at ? strtoul(at + strlen(key), nullptr, 10) : 0;
+  }
+
+  char text[256] = "";
+  size_t length = 0;
+};
+
+static uint32_t framesApplied() {
+  StatsLine stats;
+  sendStats(stats);
+  return stats.field("ok");
+}
+
+static uint32_t framesRejected() {
+  StatsLine stats;
+  sendStats(stats);
+  return stats.field("bad");
+}
+
+// Hand one frame to the firmware in pieces that fit the UART buffer, running
+// the ingest pass after each piece as the main loop would
+static void deliver(const uint8_t* data, size_t length) {
+  while (length > 0) {
+    size_t accepted = mockSerialFeed(data, length);
+    data += accepted;
+    length -= accepted;
+    processSerialData();
+  }
+  mockSerialClear();  // credit records
+}
+
+// Frames of a capture in order; JSON frames keep their newline
+class FrameCursor {
+ public:
+  FrameCursor(const uint8_t* data, size_t length, bool json) : data(data), length(length), json(json) {}
+
+  bool next(const uint8_t*& frame, size_t& frameLength) {
+    if (json) {
+      while (offset < length && data[offset] == '\n') {
+        offset++;
+      }
+      const uint8_t* end = static_cast<const uint8_t*>(memchr(data + offset, '\n', length - offset));
+      if (!end) {
+        return false;
+      }
+      frame = data + offset;
+      frameLength = end + 1 - frame;
+    } else {
+      if (offset + 2 > length) {
+        return false;
+      }
+      frame = data + offset;
+      frameLength = data[offset + 1] + 4;  // SYNC, LEN, then LEN bytes and the CRC
+    }
+    offset += frameLength;
+    return true;
+  }
+
+ private:
+  const uint8_t* data;
+  size_t length;
+  bool json;
+  size_t offset = 0;
+};
+
+static const uint8_t* jsonCapture() {
+  return reinterpret_cast<const uint8_t*>(CAPTURE_JSON);
+}
+
+static void screenRow(uint8_t row, char* out) {
+  mockLcd.rowText(row, 16, out);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The first frame ends the boot messages and puts the CPU page up
+void test_boot_shows_first_frame() {
+  setup();
+  mockAdvance(100);
+
+  FrameCursor cursor(jsonCapture(), sizeof(CAPTURE_JSON) - 1, true);
+  const uint8_t* frame;
+  size_t length;
+  TEST_ASSERT_TRUE(cursor.next(frame, length));
+  deliver(frame, length);
+
+  char row[17];
+  screenRow(0, row);
+  TEST_ASSERT_EQUAL_STRING("CPU:  52#C 12.1%", row);
+  screenRow(1, row);
+  TEST_ASSERT_EQUAL_STRING("GPU:  47#C 5.1% ", row);
+  TEST_ASSERT_EQUAL_UINT32(1, framesApplied());
+}
+
+static void benchIngest(const char* name, const uint8_t* capture, size_t length, bool json) {
+  Measure measure;
+  uint32_t appliedBefore = framesApplied();
+
+  for (uint8_t pass = 0; pass < REPEATS; pass++) {
+    FrameCursor cursor(capture, length, json);
+    const uint8_t* frame;
+    size_t frameLength;
+    while (cursor.next(frame, frameLength)) {
+      Span span(measure);
+      deliver(frame, frameLength);
+      span.stop();
+      measure.frames++;
+      mockAdvance(10);
+    }
+  }
+
+  measure.report(name);
+  TEST_ASSERT_EQUAL_UINT32(REPEATS * CAPTURE_SAMPLES, measure.frames);
+  TEST_ASSERT_EQUAL_UINT32(measure.frames, framesApplied() - appliedBefore);
+  TEST_ASSERT_EQUAL_UINT32(0, framesRejected());
+  TEST_ASSERT_EQUAL_UINT32(0, measure.allocations);
+}
+
+void test_ingest_json() {
+  benchIngest("ingest json", jsonCapture(), sizeof(CAPTURE_JSON) - 1, true);
+}
+
+void test_ingest_binary() {
+  benchIngest("ingest binary", CAPTURE_BINARY, sizeof(CAPTURE_BINARY), false);
+}
+
+// Each page redrawn after every sample. The first draw of a page (glyph
+// uploads, full repaint) is left out of the numbers, as it is not per frame.
+void test_render_pages() {
+  for (uint8_t page = 0; page < PAGES; page++) {
+    Measure measure;
+
+    for (uint8_t pass = 0; pass < REPEATS; pass++) {
+      FrameCursor cursor(jsonCapture(), sizeof(CAPTURE_JSON) - 1, true);
+      const uint8_t* frame;
+      size_t frameLength;
+      while (cursor.next(frame, frameLength)) {
+        deliver(frame, frameLength);
+        mockAdvance(10);
+
+        Span span(measure);
+        updateDisplay();
+        span.stop();
+        measure.frames++;
+      }
+    }
+
+    char name[24];
+    snprintf(name, sizeof(name), "render %s", PAGE_NAMES[page]);
+    measure.report(name);
+    TEST_ASSERT_EQUAL_UINT32(0, measure.allocations);
+    TEST_ASSERT_TRUE_MESSAGE(measure.cells <= measure.frames * PAGE_CELL_BUDGET[page], name);
+
+    changeDisplayMode();
+  }
+
+  // Back on the CPU page, showing the last sample of the capture
+  char row[17];
+  screenRow(0, row);
+  TEST_ASSERT_EQUAL_STRING("CPU:  40#C 59.7%", row);
+}
+
+// The whole firmware at the host's one-second cadence: ingest, render tick,
+// touch events and the back-channel, with a loop pass every millisecond
+void test_replay_loop() {
+  Measure measure;
+
+  FrameCursor cursor(CAPTURE_BINARY, sizeof(CAPTURE_BINARY), false);
+  const uint8_t* frame;
+  size_t frameLength;
+  while (cursor.next(frame, frameLength)) {
+    mockSerialFeed(frame, frameLength);
+    Span span(measure);
+    for (uint16_t pass = 0; pass < 1000; pass++) {
+      loop();
+      mockAdvance(1);
+    }
+    span.stop();
+    measure.frames++;
+  }
+
+  measure.report("loop 1 Hz");
+  TEST_ASSERT_EQUAL_UINT32(0, measure.allocations);
+  // One redraw per sample at most, even though the render tick fires ten times
+  TEST_ASSERT_TRUE(measure.cells <= measure.frames * PAGE_CELL_BUDGET[0]);
+}
+
+// Frames that leave the page's inputs alone are applied but never drawn
+void test_unchanged_inputs_render_nothing() {
+  changeDisplayMode();  // MEMORY
+  for (uint16_t pass = 0; pass < 100; pass++) {
+    loop();
+    mockAdvance(1);
+  }
+
+  StatsLine before;
+  sendStats(before);
+  uint32_t cells = mockLcd.cellsWritten();
+  char frame[48];
+  for (uint8_t i = 0; i < 10; i++) {
+    snprintf(frame, sizeof(frame), "{\"delta\":true,\"cpu\":{\"load\":%u}}\n", 10 + i);
+    mockSerialFeed(frame);
+    for (uint16_t pass = 0; pass < 200; pass++) {
+      loop();
+      mockAdvance(1);
+    }
+  }
+  StatsLine after;
+  sendStats(after);
+  TEST_ASSERT_EQUAL_UINT32(10, after.field("ok") - before.field("ok"));
+  TEST_ASSERT_EQUAL_UINT32(10, after.field("same") - before.field("same"));
+  TEST_ASSERT_EQUAL_UINT32(cells, mockLcd.cellsWritten());
+
+  // A RAM change is drawn
+  mockSerialFeed("{\"delta\":true,\"ram\":{\"used\":9.5}}\n");
+  for (uint16_t pass = 0; pass < 200; pass++) {
+    loop();
+    mockAdvance(1);
+  }
+  TEST_ASSERT_TRUE(mockLcd.cellsWritten() > cells);
+}
+
+// A burst bigger than the core's default 256-byte UART buffer is taken whole,
+// and the rest of a rejected line is counted and dropped up to its end
+void test_bulk_ingest() {
+  for (uint16_t pass = 0; pass < 200; pass++) {
+    loop();
+    mockAdvance(1);
+  }
+  StatsLine before;
+  sendStats(before);
+
+  char burst[640];
+  size_t used = snprintf(burst, sizeof(burst), "{\"delta\":true,\"cpu\":x123456}\n");
+  for (uint8_t i = 0; i < 16; i++) {
+    used += snprintf(burst + used, sizeof(burst) - used, "{\"delta\":true,\"cpu\":{\"load\":%u}}\n", 20 + i);
+  }
+  TEST_ASSERT_TRUE(strlen(burst) > 256);
+  TEST_ASSERT_EQUAL_UINT32(strlen(burst), mockSerialFeed(burst));
+  for (uint8_t pass = 0; pass < 4 && mockSerialPending() > 0; pass++) {
+    processSerialData();
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, mockSerialPending());
+
+  StatsLine after;
+  sendStats(after);
+  TEST_ASSERT_EQUAL_UINT32(16, after.field("ok") - before.field("ok"));
+  TEST_ASSERT_EQUAL_UINT32(1, after.field("bad") - before.field("bad"));
+  TEST_ASSERT_EQUAL_UINT32(strlen("123456}"), after.field("drop") - before.field("drop"));
+  TEST_ASSERT_EQUAL_UINT32(0, after.field("ovr") - before.field("ovr"));
+  mockSerialClear();
+}
+
+// Sequence-tagged frames are echoed once drawn, or at once when they never
+// will be, with the device's timestamps in order
+void test_latency_echo() {
+  mockSerialClear();
+  mockSerialFeed("{\"delta\":true,\"seq\":7,\"sent\":123456,\"ram\":{\"used\":10.5}}\n");
+  processSerialData();
+  TEST_ASSERT_NULL(strstr(mockSerialOutput(), "@lat"));  // waiting for the render tick
+  for (uint16_t pass = 0; pass < 200; pass++) {
+    loop();
+    mockAdvance(1);
+  }
+  const char* echo = strstr(mockSerialOutput(), "@lat seq=7 sent=123456 rx=");
+  TEST_ASSERT_NOT_NULL(echo);
+  StatsLine record;
+  record.print(echo + 4);
+  TEST_ASSERT_TRUE(record.field("done") >= record.field("rx"));
+  TEST_ASSERT_TRUE(record.field("drawn") >= record.field("done"));
+
+  // CPU load is not on the MEMORY page: echoed right away, without drawn=
+  mockSerialClear();
+  SystemData data;
+  memset(&data, 0, sizeof(data));
+  data.cpuLoad = 420;
+  uint8_t payload[METRICS_MAX_SIZE];
+  uint8_t frame[METRICS_MAX_SIZE + FRAME_OVERHEAD + 1 + FRAME_TAG_SIZE];
+  FrameTag tag = { 8, 654321 };
+  size_t length = encodeTaggedFrame(-1, tag, FRAME_METRICS, payload,
+                                    encodeMetrics(data, FIELD_CPU_LOAD, payload), frame);
+  mockSerialFeed(frame, length);
+  processSerialData();
+  echo = strstr(mockSerialOutput(), "@lat seq=8 sent=654321 rx=");
+  TEST_ASSERT_NOT_NULL(echo);
+  TEST_ASSERT_NULL(strstr(echo, "drawn="));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_boot_shows_first_frame);
+  RUN_TEST(test_ingest_json);
+  RUN_TEST(test_ingest_binary);
+  RUN_TEST(test_render_pages);
+  RUN_TEST(test_replay_loop);
+  RUN_TEST(test_unchanged_inputs_render_nothing);
+  RUN_TEST(test_bulk_ingest);
+  RUN_TEST(test_latency_echo);
+  return UNITY_END();
+}
@@ -0,0 +1,126 @@
+/*
+ *  GearPulse - local clock
+ *  --------------------------------------
+ *  LocalClock's calendar and drift correction, then the firmware keeping
+ *  DATE_TIME ticking from a single sync with no further frames.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <BinaryFrame.h>
+#include <LocalClock.h>
+#include <unity.h>
+
+void setup();
+void changeDisplayMode();
+
+// 2024-05-17 09:41:01 UTC
+const uint32_t EPOCH = 1715938861;
+
+static ClockSync syncAt(uint32_t epoch, uint16_t ms, int16_t offset, bool hour12) {
+  ClockSync sync = { epoch, ms, offset, hour12 };
+  return sync;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_calendar_and_offset() {
+  LocalClock clock;
+  SystemData data;
+  TEST_ASSERT_FALSE(clock.read(0, data));
+
+  clock.sync(syncAt(EPOCH, 0, 330, true), 1000);
+  TEST_ASSERT_TRUE(clock.read(1000, data));
+  TEST_ASSERT_EQUAL_UINT16(2024, data.datetime.year);
+  TEST_ASSERT_EQUAL_UINT8(5, data.datetime.month);
+  TEST_ASSERT_EQUAL_UINT8(17, data.datetime.day);
+  TEST_ASSERT_EQUAL_UINT8(3, data.datetime.hour);
+  TEST_ASSERT_EQUAL_UINT8(11, data.datetime.minute);
+  TEST_ASSERT_EQUAL_UINT8(1, data.datetime.second);
+  TEST_ASSERT_EQUAL_STRING("PM", data.datetime.period);
+
+  // Leap day, and a negative offset that crosses midnight
+  clock.sync(syncAt(951782400, 0, -60, false), 0);
+  clock.read(0, data);
+  TEST_ASSERT_EQUAL_UINT8(2, data.datetime.month);
+  TEST_ASSERT_EQUAL_UINT8(28, data.datetime.day);
+  TEST_ASSERT_EQUAL_UINT8(23, data.datetime.hour);
+  TEST_ASSERT_EQUAL_STRING("", data.datetime.period);
+  clock.read(3600000, data);
+  TEST_ASSERT_EQUAL_UINT8(29, data.datetime.day);
+  TEST_ASSERT_EQUAL_UINT8(0, data.datetime.hour);
+}
+
+// A device crystal running 1000 ppm slow: ten minutes of millis() is
+// 600.6 s of host time
+void test_drift_is_corrected() {
+  LocalClock clock;
+  clock.sync(syncAt(EPOCH, 0, 0, false), 0);
+  clock.sync(syncAt(EPOCH + 600, 600, 0, false), 600000);
+  TEST_ASSERT_EQUAL_INT(1000, clock.driftPpm());
+
+  // Another ten minutes later, without a sync, it is still on time
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(clock.localSeconds(1200000) - (EPOCH + 1201)));
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(clock.localSeconds(1199000) - (EPOCH + 1200)));
+}
+
+// A sync far off the local count is the host's clock changing, not drift
+void test_step_keeps_drift() {
+  LocalClock clock;
+  clock.sync(syncAt(EPOCH, 0, 0, false), 0);
+  clock.sync(syncAt(EPOCH + 600, 600, 0, false), 600000);
+  clock.sync(syncAt(EPOCH + 3600 + 700, 0, 0, false), 700000);
+  TEST_ASSERT_EQUAL_INT(1000, clock.driftPpm());
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(clock.localSeconds(700000) - (EPOCH + 4300)));
+}
+
+void test_clock_frame_round_trip() {
+  uint8_t payload[CLOCK_V1_SIZE];
+  TEST_ASSERT_EQUAL_UINT8(CLOCK_V1_SIZE, encodeClockV1(syncAt(EPOCH, 250, -300, true), payload));
+  ClockSync sync;
+  TEST_ASSERT_TRUE(decodeClockV1(payload, sizeof(payload), sync));
+  TEST_ASSERT_EQUAL_UINT32(EPOCH, sync.epoch);
+  TEST_ASSERT_EQUAL_UINT16(250, sync.millis);
+  TEST_ASSERT_EQUAL_INT(-300, sync.offsetMinutes);
+  TEST_ASSERT_TRUE(sync.hour12);
+  TEST_ASSERT_FALSE(decodeClockV1(payload, CLOCK_V1_SIZE - 1, sync));
+}
+
+// One JSON sync, then the seconds keep moving with no frames at all
+void test_firmware_ticks_without_frames() {
+  setup();
+  mockRun(100);
+  mockSerialFeed("{\"cpu\":{\"load\":12.5}}\n");
+  mockSerialFeed("{\"clock\":{\"epoch\":1715938861.5,\"offset\":0,\"hour12\":false}}\n");
+  mockRun(100);
+  for (uint8_t i = 0; i < 3; i++) {
+    changeDisplayMode();  // CPU, MEMORY, NETWORK, DATE_TIME
+  }
+  mockSerialClear();
+  mockRun(200);
+
+  char row[17];
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("05/17/2024      ", row);
+  mockLcd.rowText(1, 16, row);
+  TEST_ASSERT_EQUAL_STRING("09:41:01        ", row);
+
+  // The host may slow right down now
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "@rate 4000"));
+
+  mockRun(2000);
+  mockLcd.rowText(1, 16, row);
+  TEST_ASSERT_EQUAL_STRING("09:41:03        ", row);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_calendar_and_offset);
+  RUN_TEST(test_drift_is_corrected);
+  RUN_TEST(test_step_keeps_drift);
+  RUN_TEST(test_clock_frame_round_trip);
+  RUN_TEST(test_firmware_ticks_without_frames);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+/*
+ *  GearPulse - display backends
+ *  --------------------------------------
+ *  The SSD1306 backend drawing cells as the LCD would and sending only the
+ *  columns that changed, and the HD44780 backend on a 20x4 panel.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <MockOled.h>
+#include <CharFrameBuffer.h>
+#include <LcdDisplay.h>
+#include <Ssd1306Display.h>
+#include <unity.h>
+
+void setUp() {
+  mockOled.reset();
+  mockLcd.reset();
+}
+void tearDown() {}
+
+static void writeText(DisplayBackend& display, uint8_t col, uint8_t row, const char* text) {
+  display.writeRun(col, row, reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+// Glyphs sit one pixel in from the cell's left edge, doubled vertically
+void test_oled_draws_cells() {
+  Ssd1306Display oled;
+  oled.begin(400000);
+  TEST_ASSERT_TRUE(mockOled.displayOn());
+  TEST_ASSERT_EQUAL_UINT32(1024, mockOled.dataBytes());  // RAM cleared once
+
+  writeText(oled, 2, 1, "A");
+  oled.present();
+  // 'A' column 0 is 0x7E: rows 1-6 lit, so pixel rows 2-13 of the cell
+  TEST_ASSERT_EQUAL_HEX8(0x00, mockOled.ram(2, 16));
+  TEST_ASSERT_EQUAL_HEX8(0xFC, mockOled.ram(2, 17));
+  TEST_ASSERT_EQUAL_HEX8(0x3F, mockOled.ram(3, 17));
+  TEST_ASSERT_FALSE(mockOled.pixel(17, 17));
+  TEST_ASSERT_TRUE(mockOled.pixel(17, 18));
+
+  // A custom glyph already on screen follows its slot, as on the HD44780
+  const uint8_t lowBar[8] = { 0, 0, 0, 0, 0, 0, 0, 0x1F };
+  const uint8_t code = 3;
+  oled.writeRun(0, 3, &code, 1);
+  oled.defineGlyph(3, lowBar);
+  oled.present();
+  TEST_ASSERT_EQUAL_HEX8(0xC0, mockOled.ram(7, 1));
+  TEST_ASSERT_EQUAL_HEX8(0xC0, mockOled.ram(7, 5));
+  TEST_ASSERT_EQUAL_HEX8(0x00, mockOled.ram(7, 6));
+  TEST_ASSERT_EQUAL_HEX8(0x00, mockOled.ram(6, 1));
+  TEST_ASSERT_EQUAL_HEX8(oled.pixels(7, 1), mockOled.ram(7, 1));
+}
+
+// Only changed columns go out, and nothing when nothing changed
+void test_oled_sends_dirty_spans() {
+  Ssd1306Display oled;
+  oled.begin(400000);
+  writeText(oled, 0, 0, "CPU:  45");
+  oled.present();
+
+  mockOled.clearCounters();
+  writeText(oled, 0, 0, "CPU:  45");
+  oled.present();
+  TEST_ASSERT_EQUAL_UINT32(0, mockOled.busBytes());
+
+  // "45" to "46": the top halves of the two glyphs differ in all five
+  // columns, the bottom halves only in the first
+  uint32_t before = oled.bytesWritten();
+  writeText(oled, 0, 0, "CPU:  46");
+  oled.present();
+  TEST_ASSERT_EQUAL_UINT32(5 + 1, mockOled.dataBytes());
+  TEST_ASSERT_EQUAL_UINT32(mockOled.busBytes(), oled.bytesWritten() - before);
+  TEST_ASSERT_TRUE(mockOled.busBytes() < 32);
+
+  // Every cell of the screen changing still sends each byte once
+  mockOled.clearCounters();
+  uint8_t blocks[Ssd1306Display::COLS];
+  memset(blocks, 0xFF, sizeof(blocks));
+  for (uint8_t row = 0; row < Ssd1306Display::ROWS; row++) {
+    oled.writeRun(0, row, blocks, sizeof(blocks));
+  }
+  oled.present();
+  TEST_ASSERT_TRUE(mockOled.dataBytes() <= 1024);
+  TEST_ASSERT_EQUAL_HEX8(0xFF, mockOled.ram(0, 1));
+  TEST_ASSERT_EQUAL_HEX8(0x00, mockOled.ram(0, 7));
+}
+
+void test_oled_display_off() {
+  Ssd1306Display oled;
+  oled.begin(400000);
+  oled.setBacklight(false);
+  TEST_ASSERT_FALSE(mockOled.displayOn());
+  oled.setBacklight(true);
+  TEST_ASSERT_TRUE(mockOled.displayOn());
+}
+
+void test_lcd_20x4() {
+  LcdDisplay lcd(0x27, 20, 4);
+  CharFrameBuffer<20, 4> frame;
+  lcd.begin(400000);
+  TEST_ASSERT_EQUAL_UINT8(20, lcd.cols());
+  TEST_ASSERT_EQUAL_UINT8(4, lcd.rows());
+
+  frame.setLine(2, "CPU:  45.0C  12.5%");
+  frame.setLine(3, "GPU:  38.5C   3.0%  ");
+  frame.setCell(19, 3, '|');
+  frame.flush(lcd);
+
+  char row[21];
+  mockLcd.rowText(2, 20, row);
+  TEST_ASSERT_EQUAL_STRING("CPU:  45.0C  12.5%  ", row);
+  mockLcd.rowText(3, 20, row);
+  TEST_ASSERT_EQUAL_STRING("GPU:  38.5C   3.0% |", row);
+  mockLcd.rowText(0, 20, row);
+  TEST_ASSERT_EQUAL_STRING("                    ", row);
+  TEST_ASSERT_TRUE(lcd.bytesWritten() > 0);
+  TEST_ASSERT_EQUAL_UINT32(0, mockLcd.setupViolations());
+  TEST_ASSERT_EQUAL_UINT32(400000, lcd.busClock());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_oled_draws_cells);
+  RUN_TEST(test_oled_sends_dirty_spans);
+  RUN_TEST(test_oled_display_off);
+  RUN_TEST(test_lcd_20x4);
+  return UNITY_END();
+}
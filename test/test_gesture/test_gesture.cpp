@@ -0,0 +1,149 @@
+/*
+ *  GearPulse - touch gesture decoder and ISR queue
+ *  --------------------------------------
+ *  Library-level checks of TouchGesture thresholds, plus the firmware's
+ *  interrupt path: edges raised on the touch pin while loop() is not
+ *  running must still be timed from the edge itself.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <EventQueue.h>
+#include <TouchGesture.h>
+#include <unity.h>
+
+void setup();
+void loop();
+
+const uint16_t LONG_MS = 2000;
+const uint16_t DOUBLE_MS = 250;
+const uint16_t DEBOUNCE_MS = 15;
+
+void setUp() {}
+void tearDown() {}
+
+void test_tap_after_double_tap_window() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(true, 100));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(false, 180));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(429));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_TAP, gesture.poll(430));
+  TEST_ASSERT_FALSE(gesture.busy());
+}
+
+void test_double_tap_on_second_press() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  gesture.edge(true, 100);
+  gesture.edge(false, 180);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_DOUBLE_TAP, gesture.edge(true, 300));
+  // Nothing more, however long the second press is held
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(5000));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(false, 5100));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(6000));
+}
+
+// Without double-taps a tap comes on release, and a bounce right after it
+// doesn't make another
+void test_tap_on_release_without_double_tap() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  gesture.setDoubleTap(false);
+  gesture.edge(true, 100);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_TAP, gesture.edge(false, 180));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(true, 185));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(false, 230));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(1000));
+  TEST_ASSERT_FALSE(gesture.busy());
+
+  // A quick second tap is a tap of its own
+  gesture.edge(true, 1100);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_TAP, gesture.edge(false, 1160));
+  gesture.edge(true, 1250);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_TAP, gesture.edge(false, 1310));
+  gesture.edge(true, 2000);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_LONG_PRESS, gesture.poll(4000));
+}
+
+void test_long_press_while_held() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  gesture.edge(true, 100);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(2099));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_LONG_PRESS, gesture.poll(2100));
+  TEST_ASSERT_TRUE(gesture.pressed());
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.edge(false, 3000));
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(4000));
+}
+
+void test_glitches_are_ignored() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  // Too short to be a tap
+  gesture.edge(true, 100);
+  gesture.edge(false, 105);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_NONE, gesture.poll(1000));
+  // A dropout inside a long press doesn't split it
+  gesture.edge(true, 1000);
+  gesture.edge(false, 1500);
+  gesture.edge(true, 1505);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_LONG_PRESS, gesture.poll(3000));
+}
+
+void test_late_poll_still_reports() {
+  TouchGesture gesture(LONG_MS, DOUBLE_MS, DEBOUNCE_MS);
+  gesture.reset(false, 0);
+  gesture.edge(true, 100);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_LONG_PRESS, gesture.edge(false, 2500));
+  gesture.edge(true, 3000);
+  gesture.edge(false, 3050);
+  TEST_ASSERT_EQUAL_UINT8(GESTURE_TAP, gesture.edge(true, 4000));
+}
+
+void test_queue_keeps_order_and_reports_full() {
+  EventQueue<uint16_t, 4> queue;
+  TEST_ASSERT_TRUE(queue.push(1));
+  TEST_ASSERT_TRUE(queue.push(2));
+  TEST_ASSERT_TRUE(queue.push(3));
+  TEST_ASSERT_FALSE(queue.push(4));
+  uint16_t value;
+  TEST_ASSERT_TRUE(queue.pop(value));
+  TEST_ASSERT_EQUAL_UINT16(1, value);
+  TEST_ASSERT_TRUE(queue.push(4));
+  for (uint16_t expected = 2; expected <= 4; expected++) {
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_UINT16(expected, value);
+  }
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+// A long press is timed from the interrupt, so it takes effect at the
+// threshold even if loop() was stuck for most of it
+void test_firmware_long_press_from_isr() {
+  setup();
+  mockAdvance(3000);
+  loop();
+  mockSerialClear();
+
+  mockSetPin(D5, HIGH);
+  mockAdvance(2100);  // loop() not running, as during a long ingest pass
+  loop();
+  mockAdvance(1100);
+  loop();
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "System powered off"));
+  mockSetPin(D5, LOW);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_tap_after_double_tap_window);
+  RUN_TEST(test_double_tap_on_second_press);
+  RUN_TEST(test_tap_on_release_without_double_tap);
+  RUN_TEST(test_long_press_while_held);
+  RUN_TEST(test_glitches_are_ignored);
+  RUN_TEST(test_late_poll_still_reports);
+  RUN_TEST(test_queue_keeps_order_and_reports_full);
+  RUN_TEST(test_firmware_long_press_from_isr);
+  return UNITY_END();
+}
@@ -0,0 +1,106 @@
+/*
+ *  GearPulse - ingest to render handoff
+ *  --------------------------------------
+ *  The triple buffer the ESP32 build hands host data across cores with:
+ *  only the newest value comes out, and the producer never writes the slot
+ *  the consumer is reading. Events pushed after the consumer's mark wait for
+ *  its next pass.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <SystemData.h>
+#include <EventQueue.h>
+#include <TripleBuffer.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+void test_nothing_until_published() {
+  TripleBuffer<uint32_t> buffer;
+  TEST_ASSERT_FALSE(buffer.consume());
+
+  buffer.back() = 7;
+  TEST_ASSERT_FALSE(buffer.consume());  // filled but not yet published
+  buffer.publish();
+  TEST_ASSERT_TRUE(buffer.consume());
+  TEST_ASSERT_EQUAL_UINT32(7, buffer.front());
+  TEST_ASSERT_FALSE(buffer.consume());
+  TEST_ASSERT_EQUAL_UINT32(7, buffer.front());  // kept until the next value
+}
+
+void test_newest_value_wins() {
+  TripleBuffer<uint32_t> buffer;
+  for (uint32_t i = 1; i <= 5; i++) {
+    buffer.back() = i;
+    buffer.publish();
+  }
+  TEST_ASSERT_TRUE(buffer.consume());
+  TEST_ASSERT_EQUAL_UINT32(5, buffer.front());
+  TEST_ASSERT_FALSE(buffer.consume());
+}
+
+// However the two sides interleave, the slot being read is left alone
+void test_reader_slot_untouched() {
+  TripleBuffer<SystemData> buffer;
+  uint16_t load = 0;
+  for (uint8_t round = 0; round < 20; round++) {
+    // The producer runs ahead for a few values
+    for (uint8_t i = 0; i <= round % 3; i++) {
+      buffer.back().cpuLoad = ++load;
+      buffer.publish();
+    }
+    TEST_ASSERT_TRUE(buffer.consume());
+    const SystemData* reading = &buffer.front();
+    TEST_ASSERT_EQUAL_UINT16(load, reading->cpuLoad);
+
+    // It keeps going while the consumer is still on `reading`
+    for (uint8_t i = 0; i < 2; i++) {
+      TEST_ASSERT_TRUE(&buffer.back() != reading);
+      buffer.back().cpuLoad = 0xFFFF;
+      buffer.publish();
+      TEST_ASSERT_EQUAL_UINT16(load, reading->cpuLoad);
+    }
+    buffer.back().cpuLoad = ++load;
+    buffer.publish();
+  }
+}
+
+// Producer publishes then pushes; only events from before the mark are
+// handled, so each one finds its data already consumed
+void test_events_stop_at_mark() {
+  TripleBuffer<uint32_t> buffer;
+  EventQueue<uint32_t, 4> events;
+  buffer.back() = 1;
+  buffer.publish();
+  events.push(1);
+
+  uint8_t end = events.mark();
+  buffer.back() = 2;  // lands between the mark and the consume
+  buffer.publish();
+  events.push(2);
+
+  TEST_ASSERT_TRUE(buffer.consume());
+  uint32_t event;
+  TEST_ASSERT_TRUE(events.pop(event, end));
+  TEST_ASSERT_EQUAL_UINT32(1, event);
+  TEST_ASSERT_FALSE(events.pop(event, end));
+
+  // The next pass picks up the second event and its data
+  end = events.mark();
+  TEST_ASSERT_FALSE(buffer.consume());
+  TEST_ASSERT_TRUE(events.pop(event, end));
+  TEST_ASSERT_EQUAL_UINT32(2, event);
+  TEST_ASSERT_TRUE(buffer.front() >= event);
+  TEST_ASSERT_TRUE(events.empty());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_nothing_until_published);
+  RUN_TEST(test_newest_value_wins);
+  RUN_TEST(test_reader_slot_untouched);
+  RUN_TEST(test_events_stop_at_mark);
+  return UNITY_END();
+}
@@ -0,0 +1,76 @@
+/*
+ *  GearPulse - low-power idle
+ *  --------------------------------------
+ *  The firmware should light-sleep once the link has been quiet for a few
+ *  seconds, waking on touch or serial RX, and sleep on touch only once
+ *  powered off.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <unity.h>
+
+void setup();
+
+const uint8_t TOUCH_GPIO = D5;
+const uint8_t RX_GPIO = 3;
+
+static const char FRAME[] = "{\"cpu\":{\"load\":12.5,\"temp\":48.0}}\n";
+
+void setUp() {}
+void tearDown() {}
+
+void test_awake_while_frames_arrive() {
+  setup();
+  mockRun(100);
+  uint32_t sleeps = mockLightSleeps();
+
+  for (uint8_t i = 0; i < 10; i++) {
+    mockSerialFeed(FRAME);
+    mockRun(1000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(sleeps, mockLightSleeps());
+}
+
+void test_sleeps_when_link_quiet() {
+  uint32_t sleeps = mockLightSleeps();
+  mockRun(5000);
+  TEST_ASSERT_TRUE(mockLightSleeps() > sleeps);
+  TEST_ASSERT_EQUAL_UINT32((1u << TOUCH_GPIO) | (1u << RX_GPIO), mockWakeupPins());
+
+  // A frame keeps it up again
+  mockSerialFeed(FRAME);
+  mockRun(30);
+  sleeps = mockLightSleeps();
+  mockRun(1000);
+  TEST_ASSERT_EQUAL_UINT32(sleeps, mockLightSleeps());
+}
+
+void test_sleeps_on_touch_only_when_off() {
+  // Long press powers off
+  mockSetPin(TOUCH_GPIO, HIGH);
+  mockRun(2500);
+  mockSetPin(TOUCH_GPIO, LOW);
+  mockRun(2000);
+
+  uint32_t sleeps = mockLightSleeps();
+  mockRun(1000);
+  TEST_ASSERT_TRUE(mockLightSleeps() > sleeps);
+  TEST_ASSERT_EQUAL_UINT32(1u << TOUCH_GPIO, mockWakeupPins());
+
+  // Never while the pad is held
+  mockSetPin(TOUCH_GPIO, HIGH);
+  mockRun(30);
+  sleeps = mockLightSleeps();
+  mockRun(500);
+  TEST_ASSERT_EQUAL_UINT32(sleeps, mockLightSleeps());
+  mockSetPin(TOUCH_GPIO, LOW);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_awake_while_frames_arrive);
+  RUN_TEST(test_sleeps_when_link_quiet);
+  RUN_TEST(test_sleeps_on_touch_only_when_off);
+  return UNITY_END();
+}
@@ -0,0 +1,192 @@
+/*
+ *  GearPulse - metric schema
+ *  --------------------------------------
+ *  Path hashes from the parser against the compile-time keys, key paths at
+ *  the length limit, the metrics
+ *  frame with per-core loads, then the SENSORS and CORES pages built from
+ *  what a host reported.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <BinaryFrame.h>
+#include <JsonStreamParser.h>
+#include <MetricSchema.h>
+#include <unity.h>
+
+void setup();
+void changeDisplayMode();
+
+// Collects the keys the parser reports, as the firmware's callback sees them
+struct KeyLog {
+  uint32_t keys[8];
+  int16_t indexes[8];
+  uint8_t count;
+};
+
+static void logKey(const JsonStreamParser& parser, void* context) {
+  KeyLog& log = *static_cast<KeyLog*>(context);
+  if (log.count < 8) {
+    log.keys[log.count] = parser.pathKey();
+    log.indexes[log.count] = parser.index();
+    log.count++;
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Keys hash the same after arrays and objects close around them
+void test_path_keys_match_compile_time() {
+  KeyLog log = {};
+  JsonStreamParser parser(logKey, &log);
+  const char* line = "{\"cpu\":{\"cores\":[1,2],\"load\":5},\"fan\":{\"rpm\":900},\"host\":1}\n";
+  while (*line) {
+    parser.push(*line++);
+  }
+  TEST_ASSERT_EQUAL_UINT8(5, log.count);
+  TEST_ASSERT_EQUAL_HEX32(jsonPathKey("cpu.cores"), log.keys[0]);
+  TEST_ASSERT_EQUAL_INT16(1, log.indexes[1]);
+  TEST_ASSERT_EQUAL_HEX32(jsonPathKey("cpu.load"), log.keys[2]);
+  TEST_ASSERT_EQUAL_HEX32(jsonPathKey("fan.rpm"), log.keys[3]);
+  TEST_ASSERT_EQUAL_HEX32(jsonPathKey("host"), log.keys[4]);
+
+  TEST_ASSERT_EQUAL_INT8(METRIC_FAN_RPM, findMetric(jsonPathKey("fan.rpm")));
+  TEST_ASSERT_EQUAL_INT8(-1, findMetric(jsonPathKey("fan.speed")));
+}
+
+// A key filling the whole path can't have an object nested under it
+void test_path_limit() {
+  KeyLog log = {};
+  JsonStreamParser parser(logKey, &log);
+  char line[JSON_MAX_PATH + 16];
+  snprintf(line, sizeof(line), "{\"%.*s\":{\"b\":1}}\n", JSON_MAX_PATH, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+  JsonStreamParser::Result result = JsonStreamParser::NEED_MORE;
+  for (const char* c = line; *c && result == JsonStreamParser::NEED_MORE; c++) {
+    result = parser.push(*c);
+  }
+  TEST_ASSERT_EQUAL_INT(JsonStreamParser::PARSE_FAILED, result);
+  TEST_ASSERT_EQUAL_INT(JSON_BAD_KEY, parser.error());
+  TEST_ASSERT_EQUAL_UINT8(0, log.count);
+  TEST_ASSERT_TRUE(strlen(parser.path()) <= JSON_MAX_PATH);
+
+  // Two shorter, "a...a.b" fills the path exactly
+  parser.reset();
+  snprintf(line, sizeof(line), "{\"%.*s\":{\"b\":1}}\n", JSON_MAX_PATH - 2, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+  for (const char* c = line; *c; c++) {
+    parser.push(*c);
+  }
+  char path[JSON_MAX_PATH + 1];
+  snprintf(path, sizeof(path), "%.*s.b", JSON_MAX_PATH - 2, line + 2);
+  TEST_ASSERT_EQUAL_UINT8(1, log.count);
+  TEST_ASSERT_EQUAL_HEX32(jsonPathKey(path), log.keys[0]);
+}
+
+void test_metrics_frame_round_trip() {
+  SystemData data = {};
+  data.cpuLoad = 425;
+  data.gpuTemp = -15;
+  data.diskWrite = 3000000000u;
+  data.vramUsed = 325;
+  strcpy(data.datetime.period, "PM");
+  for (uint8_t core = 0; core < 20; core++) {
+    writeCoreLoad(data, core, core * 10);
+  }
+  TEST_ASSERT_EQUAL_UINT8(20, data.cores.count);
+
+  FieldMask mask = FIELD_CPU_LOAD | FIELD_GPU_TEMP | FIELD_DISK_WRITE | FIELD_VRAM_USED | FIELD_PERIOD | FIELD_CORES;
+  uint8_t payload[METRICS_MAX_SIZE];
+  uint8_t length = encodeMetrics(data, mask, payload);
+  TEST_ASSERT_EQUAL_UINT8(4 + 2 + 2 + 4 + 2 + 2 + 1 + 20, length);
+
+  SystemData decoded = {};
+  decoded.fanRpm = 1200;  // not in the mask, so kept
+  FieldMask decodedMask;
+  TEST_ASSERT_TRUE(decodeMetrics(payload, length, decoded, decodedMask));
+  TEST_ASSERT_EQUAL_HEX32(mask, decodedMask);
+  TEST_ASSERT_EQUAL_UINT16(425, decoded.cpuLoad);
+  TEST_ASSERT_EQUAL_INT16(-15, decoded.gpuTemp);
+  TEST_ASSERT_EQUAL_UINT32(3000000000u, decoded.diskWrite);
+  TEST_ASSERT_EQUAL_UINT16(325, decoded.vramUsed);
+  TEST_ASSERT_EQUAL_STRING("PM", decoded.datetime.period);
+  TEST_ASSERT_EQUAL_UINT8(20, decoded.cores.count);
+  TEST_ASSERT_EQUAL_UINT8(190, decoded.cores.load[19]);
+  TEST_ASSERT_EQUAL_UINT16(1200, decoded.fanRpm);
+  TEST_ASSERT_EQUAL_HEX32(0, changedFields(data, decoded) & mask);
+
+  // Per-core loads past 100 % are clamped as in JSON
+  SystemData twoCores = {};
+  writeCoreLoad(twoCores, 1, 0);
+  uint8_t overload[METRICS_MAX_SIZE];
+  uint8_t overloadLength = encodeMetrics(twoCores, FIELD_CORES, overload);
+  overload[5] = 201;  // after the mask and the core count
+  overload[6] = 255;
+  TEST_ASSERT_TRUE(decodeMetrics(overload, overloadLength, decoded, decodedMask));
+  TEST_ASSERT_EQUAL_UINT8(2, decoded.cores.count);
+  TEST_ASSERT_EQUAL_UINT8(100 * CORE_SCALE, decoded.cores.load[0]);
+  TEST_ASSERT_EQUAL_UINT8(100 * CORE_SCALE, decoded.cores.load[1]);
+  TEST_ASSERT_EQUAL_UINT8(0, decoded.cores.load[2]);
+
+  // Truncated, or carrying a metric this firmware doesn't know
+  TEST_ASSERT_FALSE(decodeMetrics(payload, length - 1, decoded, decodedMask));
+  payload[3] |= 0x80;
+  TEST_ASSERT_FALSE(decodeMetrics(payload, length, decoded, decodedMask));
+}
+
+// 32 cores at 0.5 % fit one small frame
+void test_cores_frame_size() {
+  SystemData data = {};
+  for (uint8_t core = 0; core < MAX_CORES; core++) {
+    writeCoreLoad(data, core, 200);
+  }
+  writeCoreLoad(data, MAX_CORES, 200);  // one too many is dropped
+  TEST_ASSERT_EQUAL_UINT8(MAX_CORES, data.cores.count);
+
+  uint8_t payload[METRICS_MAX_SIZE];
+  uint8_t frame[METRICS_MAX_SIZE + FRAME_OVERHEAD];
+  size_t size = encodeFrame(FRAME_METRICS, payload, encodeMetrics(data, FIELD_CORES, payload), frame);
+  TEST_ASSERT_EQUAL_UINT32(FRAME_OVERHEAD + 4 + 1 + MAX_CORES, size);
+}
+
+void test_sensor_and_core_pages() {
+  setup();
+  mockRun(100);
+  mockSerialFeed("{\"cpu\":{\"load\":40,\"cores\":[100,0,50,50,50,50,50,50,50,50,50,50,50,50,50,50,25,75]},"
+                 "\"fan\":{\"rpm\":1200},\"vram\":{\"used\":3.25}}\n");
+  mockRun(100);
+  for (uint8_t i = 0; i < 6; i++) {
+    changeDisplayMode();  // on to SENSORS
+  }
+  mockRun(20);
+
+  // Only what the host sent, two rows per view
+  char row[17];
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("VRAM used  3.2GB", row);
+  mockLcd.rowText(1, 16, row);
+  TEST_ASSERT_EQUAL_STRING("Fan      1200rpm", row);
+
+  changeDisplayMode();
+  mockRun(20);
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("Cores 1-16   50%", row);
+  TEST_ASSERT_EQUAL_HEX8(0xFF, mockLcd.cell(0, 1));
+  TEST_ASSERT_EQUAL_HEX8('_', mockLcd.cell(1, 1));
+
+  // The remaining cores after a few seconds
+  mockRun(3000);
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("Cores 17-18  50%", row);
+  TEST_ASSERT_EQUAL_HEX8(' ', mockLcd.cell(2, 1));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_path_keys_match_compile_time);
+  RUN_TEST(test_path_limit);
+  RUN_TEST(test_metrics_frame_round_trip);
+  RUN_TEST(test_cores_frame_size);
+  RUN_TEST(test_sensor_and_core_pages);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+ *  GearPulse - persisted settings and fast boot
+ *  --------------------------------------
+ *  Settings changes reach the EEPROM sector once things settle rather than
+ *  on every tap, survive a reboot (a second setup() on the same sector),
+ *  and a damaged image falls back to the defaults.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <Settings.h>
+#include <EEPROM.h>
+#include <unity.h>
+
+void setup();
+void changeDisplayMode();
+
+static const char FRAME[] = "{\"cpu\":{\"load\":12.5,\"temp\":48.0},\"ram\":{\"total\":16,\"used\":8,\"usagePercent\":50}}\n";
+
+static void command(const char* line) {
+  mockSerialClear();
+  mockSerialFeed(line);
+  mockRun(10);
+}
+
+static void screenRow(uint8_t row, char* out) {
+  mockLcd.rowText(row, 16, out);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_blank_sector_gives_defaults() {
+  mockEepromErase();
+  setup();
+  command("settings\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "@settings mode=0 pages=255 rate=10 backlight=0 fastboot=0 baud=115200"));
+  TEST_ASSERT_EQUAL_UINT32(0, mockEepromCommits());
+}
+
+// Paging around is one write once the taps stop, not one per tap
+void test_commits_are_deferred() {
+  mockSerialFeed(FRAME);
+  mockRun(100);
+  for (uint8_t i = 0; i < 9; i++) {
+    changeDisplayMode();
+    mockRun(500);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, mockEepromCommits());
+  mockRun(10000);
+  TEST_ASSERT_EQUAL_UINT32(1, mockEepromCommits());
+}
+
+void test_set_rejects_bad_values() {
+  command("set pages=0\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "@error bad setting: pages=0"));
+  command("set rate=200\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "@error bad setting"));
+  command("set colour=1\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "@error bad setting"));
+}
+
+// The page last shown comes back after a reboot, and fast boot goes
+// straight to waiting for data
+void test_reboot_restores_page_and_fast_boot() {
+  command("set fastboot=1\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "mode=1"));  // MEMORY, after nine taps
+  mockRun(10000);
+
+  setup();
+  char row[17];
+  screenRow(1, row);
+  TEST_ASSERT_EQUAL_STRING("Waiting for data", row);
+
+  mockSerialFeed(FRAME);
+  mockRun(20);
+  screenRow(0, row);
+  TEST_ASSERT_EQUAL_STRING("RAM: 8/16GB 50% ", row);
+}
+
+// Pages left out of the rotation are skipped, including the one on screen
+void test_disabled_pages_are_skipped() {
+  command("set pages=9\n");  // CPU and DATE_TIME, while MEMORY is shown
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "mode=3 pages=9"));
+  changeDisplayMode();
+  command("settings\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "mode=0"));
+  changeDisplayMode();
+  command("settings\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "mode=3"));
+}
+
+void test_corrupt_image_gives_defaults() {
+  mockRun(10000);
+  uint32_t commits = mockEepromCommits();
+  TEST_ASSERT_TRUE(commits > 1);
+
+  // Flip one bit of the stored render rate behind the firmware's back
+  EEPROM.begin(SETTINGS_SIZE);
+  EEPROM.write(4, EEPROM.read(4) ^ 0x01);
+  EEPROM.commit();
+
+  setup();
+  command("settings\n");
+  TEST_ASSERT_NOT_NULL(strstr(mockSerialOutput(), "pages=255 rate=10 backlight=0 fastboot=0"));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_blank_sector_gives_defaults);
+  RUN_TEST(test_commits_are_deferred);
+  RUN_TEST(test_set_rejects_bad_values);
+  RUN_TEST(test_reboot_restores_page_and_fast_boot);
+  RUN_TEST(test_disabled_pages_are_skipped);
+  RUN_TEST(test_corrupt_image_gives_defaults);
+  return UNITY_END();
+}
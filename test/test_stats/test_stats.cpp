@@ -0,0 +1,100 @@
+/*
+ *  GearPulse - rolling statistics
+ *  --------------------------------------
+ *  WindowStats extremes ageing out a bucket at a time and the time-weighted
+ *  average, then the STATS page summarizing what the host sent.
+ */
+
+#include <Arduino.h>
+#include <NativeMock.h>
+#include <MockLcd.h>
+#include <WindowStats.h>
+#include <unity.h>
+
+void setup();
+void changeDisplayMode();
+
+void setUp() {}
+void tearDown() {}
+
+void test_extremes_age_out() {
+  WindowStats<60000, 6> stats;
+  int32_t low, high;
+  TEST_ASSERT_FALSE(stats.range(0, low, high));
+
+  stats.add(900, 1000);
+  stats.add(100, 2000);
+  for (uint32_t t = 10000; t <= 60000; t += 10000) {
+    stats.add(500, t);
+  }
+  TEST_ASSERT_TRUE(stats.range(60000, low, high));
+  TEST_ASSERT_EQUAL_INT(100, low);
+  TEST_ASSERT_EQUAL_INT(900, high);
+
+  // The first bucket leaves the window once a full window has passed
+  TEST_ASSERT_TRUE(stats.range(61000, low, high));
+  TEST_ASSERT_EQUAL_INT(500, low);
+  TEST_ASSERT_EQUAL_INT(500, high);
+
+  // And everything goes once the host has been quiet for a window
+  TEST_ASSERT_FALSE(stats.range(130000, low, high));
+}
+
+// Samples are weighted by the time they cover, not by how many arrive
+void test_average_is_time_weighted() {
+  WindowStats<60000, 6> stats;
+  stats.add(0, 0);
+  for (uint32_t t = 1000; t <= 600000; t += 1000) {
+    stats.add(1000, t);
+  }
+  TEST_ASSERT_EQUAL_INT(1000, stats.average());
+
+  // A burst of 100 samples in one millisecond barely moves it
+  for (uint8_t i = 0; i < 100; i++) {
+    stats.add(0, 600001);
+  }
+  TEST_ASSERT_TRUE(stats.average() >= 999);
+
+  for (uint32_t t = 601000; t <= 660000; t += 1000) {
+    stats.add(0, t);
+  }
+  // One time constant later it has come down by about 1 - 1/e
+  TEST_ASSERT_TRUE(stats.average() > 330 && stats.average() < 410);
+}
+
+void test_stats_page() {
+  setup();
+  mockRun(100);
+  const char* frames[] = {
+    "{\"cpu\":{\"load\":20.0,\"temp\":40.0}}\n",
+    "{\"cpu\":{\"load\":80.0,\"temp\":60.0}}\n",
+    "{\"cpu\":{\"load\":50.0,\"temp\":50.0}}\n",
+  };
+  for (uint8_t i = 0; i < 3; i++) {
+    mockSerialFeed(frames[i]);
+    mockRun(1000);
+  }
+  for (uint8_t i = 0; i < 5; i++) {
+    changeDisplayMode();  // on to STATS
+  }
+  mockRun(20);
+
+  char row[17];
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("CPU load      1m", row);
+  mockLcd.rowText(1, 16, row);
+  TEST_ASSERT_EQUAL_STRING("20%/22%/80%     ", row);
+
+  // Every metric over one minute, then over fifteen
+  mockRun(6 * 3000);
+  mockLcd.rowText(0, 16, row);
+  TEST_ASSERT_EQUAL_STRING("CPU load     15m", row);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_extremes_age_out);
+  RUN_TEST(test_average_is_time_weighted);
+  RUN_TEST(test_stats_page);
+  return UNITY_END();
+}